@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/handlers.hpp"
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+
+auto make_context()
+{
+    return dbc::details::make_context(dbc::contract::invariant, "x == 0", "8 == 0", "main",
+                                      "path_to_buzz/buzz.cpp", 100, "What");
+}
+
+// Forks a child that reports a violation to the given handler, and waits for it to abort.
+void time_to_abort(benchmark::State& state, const dbc::violation_handler& handler)
+{
+    for (auto _ : state)
+    {
+        const auto pid = ::fork();
+        if (pid == 0)
+        {
+            const auto null = ::open("/dev/null", O_WRONLY);
+            ::dup2(null, STDERR_FILENO);
+
+            const rlimit no_core{0, 0};
+            ::setrlimit(RLIMIT_CORE, &no_core);
+
+            dbc::set_violation_handler(handler);
+            DBC_INVARIANT(state.iterations() < 0, "What");
+            ::_exit(EXIT_SUCCESS);
+        }
+
+        int status{};
+        ::waitpid(pid, &status, 0);
+        if (!WIFSIGNALED(status) || WTERMSIG(status) != SIGABRT)
+            state.SkipWithError("child did not abort");
+    }
+}
+
+void BM_abort_handler_time_to_abort(benchmark::State& state)
+{
+    time_to_abort(state, dbc::abort_handler);
+}
+
+void BM_safe_abort_handler_time_to_abort(benchmark::State& state)
+{
+    time_to_abort(state, dbc::safe_abort_handler);
+}
+
+void BM_ostream_format(benchmark::State& state)
+{
+    const auto context = make_context();
+
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        os << context << '\n';
+        benchmark::DoNotOptimize(os.str());
+    }
+}
+
+void BM_fixed_buffer_format(benchmark::State& state)
+{
+    const auto context = make_context();
+
+    for (auto _ : state)
+    {
+        dbc::details::fixed_buffer<4096> buf;
+        dbc::details::format(buf, context);
+        benchmark::DoNotOptimize(buf.data());
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_abort_handler_time_to_abort)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_safe_abort_handler_time_to_abort)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ostream_format);
+BENCHMARK(BM_fixed_buffer_format);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "assume_kernels.hpp"
+#include <benchmark/benchmark.h>
+#include <numeric>
+
+namespace
+{
+
+constexpr auto size = std::size_t{1} << 14;
+
+template <auto Kernel>
+void BM_sum_at(benchmark::State& state)
+{
+    std::vector<int> v(size);
+    std::iota(std::begin(v), std::end(v), 0);
+
+    for (auto _ : state) benchmark::DoNotOptimize(Kernel(v, v.size()));
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(int)));
+}
+
+template <auto Kernel>
+void BM_scale(benchmark::State& state)
+{
+    std::vector<int> src(size, 3), dst(size);
+
+    for (auto _ : state)
+    {
+        Kernel(dst.data(), src.data(), size, 7);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(int)));
+}
+
+template <auto Kernel>
+void BM_dot(benchmark::State& state)
+{
+    std::vector<int> lhs(size, 3), rhs(size, 5);
+
+    for (auto _ : state) benchmark::DoNotOptimize(Kernel(lhs.data(), rhs.data(), size));
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(int)));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_sum_at, unchecked::sum_at);
+BENCHMARK_TEMPLATE(BM_sum_at, assumed::sum_at);
+BENCHMARK_TEMPLATE(BM_scale, unchecked::scale);
+BENCHMARK_TEMPLATE(BM_scale, assumed::scale);
+BENCHMARK_TEMPLATE(BM_dot, unchecked::dot);
+BENCHMARK_TEMPLATE(BM_dot, assumed::dot);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_BENCHMARKS_ASSUME_KERNELS_H
+#define DBC_BENCHMARKS_ASSUME_KERNELS_H
+
+#include <cstddef>
+#include <vector>
+
+// Vectorizable kernels with contracts that are disabled (DBC_ASSERT_LEVEL_NONE), compiled once as
+// noops (namespace unchecked) and once as assumptions (namespace assumed, DBC_ASSUME_UNCHECKED).
+
+#define DBC_DECLARE_ASSUME_KERNELS                                                                 \
+    auto sum_at(const std::vector<int>& v, std::size_t n) -> int;                                 \
+    void scale(int* dst, const int* src, std::size_t n, int k);                                    \
+    auto dot(const int* lhs, const int* rhs, std::size_t n) -> int;
+
+namespace unchecked
+{
+DBC_DECLARE_ASSUME_KERNELS
+} // namespace unchecked
+
+namespace assumed
+{
+DBC_DECLARE_ASSUME_KERNELS
+} // namespace assumed
+
+#undef DBC_DECLARE_ASSUME_KERNELS
+
+#endif // DBC_BENCHMARKS_ASSUME_KERNELS_H
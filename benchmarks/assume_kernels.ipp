@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Kernel definitions, included by the unchecked and assumed kernel translation units.
+// Expects DBC_ASSUME_KERNELS_NAMESPACE to be defined.
+
+#include "assume_kernels.hpp"
+#include "dbc/dbc.hpp"
+
+namespace DBC_ASSUME_KERNELS_NAMESPACE
+{
+
+// Bounds-check elimination: v.at(i) cannot throw if n <= v.size().
+auto sum_at(const std::vector<int>& v, std::size_t n) -> int
+{
+    DBC_REQUIRE(n <= v.size());
+
+    auto res = 0;
+    for (std::size_t i = 0; i < n; ++i) res += v.at(i);
+    return res;
+}
+
+// Remainder loop elimination: n is a multiple of the vector width.
+void scale(int* dst, const int* src, std::size_t n, int k)
+{
+    DBC_REQUIRE(dst != nullptr && src != nullptr);
+    DBC_REQUIRE(n % 16 == 0);
+    DBC_REQUIRE(dst + n <= src || src + n <= dst, "Non-overlapping ranges");
+
+    for (std::size_t i = 0; i < n; ++i) dst[i] = k * src[i];
+}
+
+// Remainder loop elimination, for a reduction.
+auto dot(const int* lhs, const int* rhs, std::size_t n) -> int
+{
+    DBC_REQUIRE(n % 16 == 0);
+
+    auto res = 0;
+    for (std::size_t i = 0; i < n; ++i) res += lhs[i] * rhs[i];
+    return res;
+}
+
+} // namespace DBC_ASSUME_KERNELS_NAMESPACE
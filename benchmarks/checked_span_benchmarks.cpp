@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#define DBC_ASSERT_LEVEL_PRECONDITIONS
+
+#include "dbc/checked_span.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+constexpr auto size = std::size_t{1} << 16;
+
+auto make_values()
+{
+    std::vector<int> v(size);
+    std::iota(std::begin(v), std::end(v), 0);
+    return v;
+}
+
+// The unchecked baseline.
+void BM_unchecked_index(benchmark::State& state)
+{
+    const auto v = make_values();
+
+    for (auto _ : state)
+    {
+        int sum{0};
+        for (std::size_t i = 0; i < v.size(); ++i) sum += v[i];
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// The unchecked range-based baseline.
+void BM_unchecked_range_for(benchmark::State& state)
+{
+    const auto v = make_values();
+    const std::span<const int> s{v};
+
+    for (auto _ : state)
+    {
+        int sum{0};
+        for (auto x : s) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// A precondition per element, as written without checked spans.
+void BM_require_per_element(benchmark::State& state)
+{
+    const auto v = make_values();
+    const auto n = static_cast<std::size_t>(state.range(0)); // opaque, not to be hoisted
+
+    for (auto _ : state)
+    {
+        int sum{0};
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            DBC_REQUIRE(i < v.size());
+            sum += v[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// Checked indexing, a branch per element.
+void BM_checked_span_index(benchmark::State& state)
+{
+    const auto v = make_values();
+    const dbc::checked_span s{v};
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        int sum{0};
+        for (std::size_t i = 0; i < n; ++i) sum += s[i];
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// Range-based iteration, in bounds by construction.
+void BM_checked_span_range_for(benchmark::State& state)
+{
+    const auto v = make_values();
+    const dbc::checked_span s{v};
+
+    for (auto _ : state)
+    {
+        int sum{0};
+        for (auto x : s) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// Iteration over checked sub-spans, a check per chunk.
+void BM_checked_span_chunks(benchmark::State& state)
+{
+    const auto v = make_values();
+    const dbc::checked_span s{v};
+    const auto chunk = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        int sum{0};
+        for (std::size_t offset = 0; offset < s.size(); offset += chunk)
+            for (auto x : s.subspan(offset, std::min(chunk, s.size() - offset))) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+} // namespace
+
+BENCHMARK(BM_unchecked_index);
+BENCHMARK(BM_unchecked_range_for);
+BENCHMARK(BM_require_per_element)->Arg(size);
+BENCHMARK(BM_checked_span_index)->Arg(size);
+BENCHMARK(BM_checked_span_range_for);
+BENCHMARK(BM_checked_span_chunks)->Arg(256)->Arg(4096);
+
+BENCHMARK_MAIN();
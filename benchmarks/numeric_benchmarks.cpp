@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dbc/numeric.hpp"
+#include <benchmark/benchmark.h>
+#include <numeric>
+
+namespace
+{
+
+using dbc::details::numeric_check;
+using dbc::details::simd_level;
+
+constexpr auto size = std::size_t{1} << 16;
+
+// The loops an invariant would be written with, without the numeric predicates.
+
+template <typename T>
+auto naive_all_finite(const std::vector<T>& v)
+{
+    for (auto x : v)
+        if (!std::isfinite(x)) return false;
+    return true;
+}
+
+template <typename T>
+auto naive_all_in_range(const std::vector<T>& v, T lo, T hi)
+{
+    for (auto x : v)
+        if (!(x >= lo && x <= hi)) return false;
+    return true;
+}
+
+template <typename T>
+auto naive_is_monotonic(const std::vector<T>& v)
+{
+    for (std::size_t i = 1; i < v.size(); ++i)
+        if (!(v[i - 1] <= v[i])) return false;
+    return true;
+}
+
+template <typename T>
+auto make_values()
+{
+    std::vector<T> v(size);
+    std::iota(std::begin(v), std::end(v), T{});
+    return v;
+}
+
+template <numeric_check Check, typename T>
+void BM_naive(benchmark::State& state)
+{
+    const auto v = make_values<T>();
+
+    for (auto _ : state)
+    {
+        if constexpr (Check == numeric_check::finite)
+            benchmark::DoNotOptimize(naive_all_finite(v));
+        else if constexpr (Check == numeric_check::in_range)
+            benchmark::DoNotOptimize(naive_all_in_range(v, T{}, static_cast<T>(size)));
+        else
+            benchmark::DoNotOptimize(naive_is_monotonic(v));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(T)));
+}
+
+// Benchmarks a kernel, by the instruction set passed as the argument.
+template <numeric_check Check, typename T>
+void BM_kernel(benchmark::State& state)
+{
+    const auto level = static_cast<simd_level>(state.range(0));
+    if (level > dbc::details::active_simd_level())
+    {
+        state.SkipWithError("Unsupported instruction set");
+        return;
+    }
+
+    const auto v = make_values<T>();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dbc::details::find_offending<Check>(
+            level, v.data(), v.size(), T{}, static_cast<T>(size)));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(T)));
+}
+
+void simd_levels(benchmark::internal::Benchmark* b)
+{
+    for (auto l : {simd_level::scalar, simd_level::sse2, simd_level::avx2, simd_level::avx512})
+        b->Arg(static_cast<int64_t>(l));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_naive, numeric_check::finite, float);
+BENCHMARK_TEMPLATE(BM_kernel, numeric_check::finite, float)->Apply(simd_levels);
+BENCHMARK_TEMPLATE(BM_naive, numeric_check::finite, double);
+BENCHMARK_TEMPLATE(BM_kernel, numeric_check::finite, double)->Apply(simd_levels);
+BENCHMARK_TEMPLATE(BM_naive, numeric_check::in_range, float);
+BENCHMARK_TEMPLATE(BM_kernel, numeric_check::in_range, float)->Apply(simd_levels);
+BENCHMARK_TEMPLATE(BM_naive, numeric_check::in_range, std::int32_t);
+BENCHMARK_TEMPLATE(BM_kernel, numeric_check::in_range, std::int32_t)->Apply(simd_levels);
+BENCHMARK_TEMPLATE(BM_naive, numeric_check::monotonic, double);
+BENCHMARK_TEMPLATE(BM_kernel, numeric_check::monotonic, double)->Apply(simd_levels);
+BENCHMARK_TEMPLATE(BM_naive, numeric_check::monotonic, std::int64_t);
+BENCHMARK_TEMPLATE(BM_kernel, numeric_check::monotonic, std::int64_t)->Apply(simd_levels);
+
+BENCHMARK_MAIN();
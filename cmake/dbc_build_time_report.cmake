@@ -0,0 +1,194 @@
+# Reports the build time of a synthetic project of UNITS translation units that use the dbc
+# contracts, serially compiled, with:
+#  textual: each unit includes dbc/dbc.hpp
+#  pch:     as textual, with the standard headers of dbc/dbc_pch.hpp precompiled once
+#  module:  each unit includes dbc/dbc_macros.hpp and imports the dbc module, compiled once
+# The one-time precompilations are included in the totals. The module build runs only if
+# MODULE_FLAGS are given, as the module support of the compilers varies.
+#
+# Usage: cmake -DCXX=<compiler> -DCOMPILER_ID=<GNU|Clang> -DINCLUDE_DIR=<dir> -DOUTPUT_DIR=<dir>
+#              -DMODULE_SOURCE=<dbc.cppm> [-DUNITS=64] [-DCXX_FLAGS="-O2"]
+#              [-DMODULE_FLAGS="-fmodules-ts"] -P dbc_build_time_report.cmake
+
+cmake_minimum_required(VERSION 3.23) # string(TIMESTAMP) %f
+
+foreach(VAR CXX COMPILER_ID INCLUDE_DIR OUTPUT_DIR MODULE_SOURCE)
+  if(NOT ${VAR})
+    message(FATAL_ERROR "dbc_build_time_report: ${VAR} is not set")
+  endif()
+endforeach()
+
+if(NOT UNITS)
+  set(UNITS 64)
+endif()
+
+if(NOT DEFINED CXX_FLAGS)
+  set(CXX_FLAGS "-O2")
+endif()
+
+separate_arguments(CXX_FLAGS)
+separate_arguments(MODULE_FLAGS)
+
+set(COMPILE "${CXX}" -std=c++20 -I "${INCLUDE_DIR}" ${CXX_FLAGS})
+
+# ------------------------- Synthetic project -------------------------------------------- #
+
+# Writes the translation units of a variant, given their prologue, and returns their paths.
+function(write_units VARIANT PROLOGUE OUT)
+  file(MAKE_DIRECTORY "${OUTPUT_DIR}/${VARIANT}")
+  set(SOURCES "")
+  math(EXPR LAST "${UNITS} - 1")
+
+  foreach(U RANGE ${LAST})
+    set(CONTENT "#define DBC_ASSERT_LEVEL_INVARIANTS\n${PROLOGUE}\n")
+
+    foreach(F RANGE 7)
+      string(APPEND CONTENT
+        "auto unit${U}_f${F}(int a, long b) -> long\n"
+        "{\n"
+        "    DBC_REQUIRE(a >= 0, \"a is {} in unit ${U}\", a);\n"
+        "    DBC_REQUIRE(b != a);\n"
+        "    const auto res = b * ${F} + a;\n"
+        "    DBC_ENSURE(res >= b * ${F});\n"
+        "    return res;\n"
+        "}\n\n")
+    endforeach()
+
+    set(SOURCE "${OUTPUT_DIR}/${VARIANT}/unit${U}.cpp")
+    file(WRITE "${SOURCE}" "${CONTENT}")
+    list(APPEND SOURCES "${SOURCE}")
+  endforeach()
+
+  set(${OUT} ${SOURCES} PARENT_SCOPE)
+endfunction()
+
+# ------------------------- Measurements ------------------------------------------------- #
+
+# Returns the current time in microseconds.
+function(now_us OUT)
+  string(TIMESTAMP SECONDS "%s" UTC)
+  string(TIMESTAMP MICROSECONDS "%f" UTC)
+  math(EXPR RES "${SECONDS} * 1000000 + ${MICROSECONDS}")
+  set(${OUT} ${RES} PARENT_SCOPE)
+endfunction()
+
+# Runs a compile command, in the directory of a variant, and adds its duration (us) to a variable.
+function(timed_compile VARIANT OUT)
+  now_us(START)
+  execute_process(COMMAND ${ARGN} WORKING_DIRECTORY "${OUTPUT_DIR}/${VARIANT}"
+    RESULT_VARIABLE FAILED ERROR_VARIABLE ERRORS)
+  now_us(STOP)
+
+  if(FAILED)
+    message(FATAL_ERROR "dbc_build_time_report: ${VARIANT} compilation failed:\n${ERRORS}")
+  endif()
+
+  math(EXPR RES "${${OUT}} + ${STOP} - ${START}")
+  set(${OUT} ${RES} PARENT_SCOPE)
+endfunction()
+
+# Compiles the units of a variant, with extra flags, and adds the duration (us) to a variable.
+function(compile_units VARIANT SOURCES OUT)
+  set(RES ${${OUT}})
+  foreach(SOURCE ${SOURCES})
+    timed_compile(${VARIANT} RES ${COMPILE} ${ARGN} -c "${SOURCE}" -o "${SOURCE}.o")
+  endforeach()
+  set(${OUT} ${RES} PARENT_SCOPE)
+endfunction()
+
+set(VARIANTS "")
+set(TIMES "")
+
+# textual
+write_units(textual "#include \"dbc/dbc.hpp\"" SOURCES)
+set(TEXTUAL 0)
+compile_units(textual "${SOURCES}" TEXTUAL)
+list(APPEND VARIANTS textual)
+list(APPEND TIMES ${TEXTUAL})
+
+# pch
+write_units(pch "#include \"dbc/dbc.hpp\"" SOURCES)
+set(PCH_HEADER "${OUTPUT_DIR}/pch/dbc_pch.hpp")
+file(WRITE "${PCH_HEADER}" "#include \"dbc/dbc_pch.hpp\"\n")
+set(PCH 0)
+
+if(COMPILER_ID MATCHES "Clang")
+  timed_compile(pch PCH ${COMPILE} -x c++-header "${PCH_HEADER}" -o "${PCH_HEADER}.pch")
+  compile_units(pch "${SOURCES}" PCH -include-pch "${PCH_HEADER}.pch")
+else()
+  timed_compile(pch PCH ${COMPILE} -x c++-header "${PCH_HEADER}" -o "${PCH_HEADER}.gch")
+  compile_units(pch "${SOURCES}" PCH -Winvalid-pch -include "${PCH_HEADER}")
+endif()
+
+list(APPEND VARIANTS pch)
+list(APPEND TIMES ${PCH})
+
+# module
+if(MODULE_FLAGS)
+  write_units(module "#include \"dbc/dbc_macros.hpp\"\nimport dbc;" SOURCES)
+  set(MODULE 0)
+
+  if(COMPILER_ID MATCHES "Clang")
+    set(PCM "${OUTPUT_DIR}/module/dbc.pcm")
+    timed_compile(module MODULE
+      ${COMPILE} ${MODULE_FLAGS} --precompile -x c++-module "${MODULE_SOURCE}" -o "${PCM}")
+    compile_units(module "${SOURCES}" MODULE ${MODULE_FLAGS} -fmodule-file=dbc=${PCM})
+  else()
+    timed_compile(module MODULE
+      ${COMPILE} ${MODULE_FLAGS} -x c++ -c "${MODULE_SOURCE}" -o "${OUTPUT_DIR}/module/dbc.o")
+    compile_units(module "${SOURCES}" MODULE ${MODULE_FLAGS})
+  endif()
+
+  list(APPEND VARIANTS module)
+  list(APPEND TIMES ${MODULE})
+endif()
+
+# ------------------------- Report ------------------------------------------------------- #
+
+# Returns a value padded to the given width, right aligned, or left aligned if width is negative.
+function(pad VALUE WIDTH OUT)
+  string(LENGTH "${VALUE}" LENGTH)
+  if(WIDTH LESS 0)
+    math(EXPR COUNT "-(${WIDTH}) - ${LENGTH}")
+  else()
+    math(EXPR COUNT "${WIDTH} - ${LENGTH}")
+  endif()
+  set(SPACES "")
+  if(COUNT GREATER 0)
+    string(REPEAT " " ${COUNT} SPACES)
+  endif()
+  if(WIDTH LESS 0)
+    set(${OUT} "${VALUE}${SPACES}" PARENT_SCOPE)
+  else()
+    set(${OUT} "${SPACES}${VALUE}" PARENT_SCOPE)
+  endif()
+endfunction()
+
+# Appends a table row of values, padded to the given widths, to a variable.
+function(append_row OUT VALUES WIDTHS)
+  set(ROW "")
+  foreach(VALUE WIDTH IN ZIP_LISTS VALUES WIDTHS)
+    pad("${VALUE}" ${WIDTH} CELL)
+    string(APPEND ROW "${CELL}")
+  endforeach()
+  set(${OUT} "${${OUT}}${ROW}\n" PARENT_SCOPE)
+endfunction()
+
+set(WIDTHS -10 12 15 10)
+
+set(TABLE "dbc build time report: ${UNITS} translation units, serial, flags: ${CXX_FLAGS}\n\n")
+append_row(TABLE "variant;total(ms);per unit(ms);speedup" "${WIDTHS}")
+
+foreach(VARIANT TIME IN ZIP_LISTS VARIANTS TIMES)
+  math(EXPR MS "${TIME} / 1000")
+  math(EXPR PER_UNIT "${TIME} / 1000 / ${UNITS}")
+  math(EXPR SPEEDUP "${TEXTUAL} * 100 / ${TIME}")
+  string(REGEX REPLACE "([0-9][0-9])$" ".\\1x" SPEEDUP "00${SPEEDUP}")
+  string(REGEX REPLACE "^0+([0-9])" "\\1" SPEEDUP "${SPEEDUP}")
+
+  append_row(TABLE "${VARIANT};${MS};${PER_UNIT};${SPEEDUP}" "${WIDTHS}")
+endforeach()
+
+set(REPORT "${OUTPUT_DIR}/dbc_build_time_report.txt")
+file(WRITE "${REPORT}" "${TABLE}")
+message("${TABLE}\nWritten to: ${REPORT}")
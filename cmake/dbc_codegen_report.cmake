@@ -0,0 +1,167 @@
+# Reports the codegen impact of the dbc contracts, per assert level.
+#
+# Compiles a synthetic translation unit with SITES DBC_REQUIRE/DBC_ENSURE/DBC_INVARIANT sites, once
+# per DBC_ASSERT_LEVEL_*, and reports the object size, the text size per (enabled or not) site, the
+# number of instantiated dbc::details::rhs_decomposer functions and the compile time.
+#
+# Usage: cmake -DCXX=<compiler> -DINCLUDE_DIR=<dir> -DOUTPUT_DIR=<dir> -DNM=<nm> -DSIZE=<size>
+#              [-DSITES=3000] [-DCXX_FLAGS="-O2"] -P dbc_codegen_report.cmake
+
+cmake_minimum_required(VERSION 3.23) # string(TIMESTAMP) %f
+
+foreach(VAR CXX INCLUDE_DIR OUTPUT_DIR NM SIZE)
+  if(NOT ${VAR})
+    message(FATAL_ERROR "dbc_codegen_report: ${VAR} is not set")
+  endif()
+endforeach()
+
+if(NOT SITES)
+  set(SITES 3000)
+endif()
+
+if(NOT DEFINED CXX_FLAGS)
+  set(CXX_FLAGS "-O2")
+endif()
+
+separate_arguments(CXX_FLAGS)
+
+# ------------------------- Synthetic translation unit ----------------------------------- #
+
+math(EXPR FUNCTIONS "(${SITES} + 2) / 3")
+math(EXPR LAST "${FUNCTIONS} - 1")
+
+set(SOURCE "${OUTPUT_DIR}/dbc_codegen_synthetic.cpp")
+set(CONTENT "#include \"dbc/dbc.hpp\"\n#include <string>\n\n")
+
+# Rotate the operand types, to instantiate a realistic mix of decomposers.
+foreach(I RANGE ${LAST})
+  math(EXPR KIND "${I} % 4")
+  if(KIND EQUAL 0)
+    set(ARGS "int a, int b")
+    set(LHS "a")
+    set(RHS "b + ${I}")
+  elseif(KIND EQUAL 1)
+    set(ARGS "long a, unsigned b")
+    set(LHS "a")
+    set(RHS "static_cast<long>(b) * ${I}")
+  elseif(KIND EQUAL 2)
+    set(ARGS "double a, float b")
+    set(LHS "a")
+    set(RHS "b + ${I}.5")
+  else()
+    set(ARGS "const std::string& a, const char* b")
+    set(LHS "a.size()")
+    set(RHS "std::char_traits<char>::length(b) + ${I}")
+  endif()
+
+  string(APPEND CONTENT
+    "auto f${I}(${ARGS}) -> bool\n"
+    "{\n"
+    "    DBC_REQUIRE(${LHS} != ${RHS});\n"
+    "    DBC_INVARIANT(${LHS} >= ${RHS}, \"Site ${I}\");\n"
+    "    const auto res = ${LHS} < ${RHS};\n"
+    "    DBC_ENSURE(res == (${LHS} < ${RHS}));\n"
+    "    return res;\n"
+    "}\n\n")
+endforeach()
+
+file(WRITE "${SOURCE}" "${CONTENT}")
+
+# ------------------------- Measurements ------------------------------------------------- #
+
+# Returns the current time in microseconds.
+function(now_us OUT)
+  string(TIMESTAMP SECONDS "%s" UTC)
+  string(TIMESTAMP MICROSECONDS "%f" UTC)
+  math(EXPR RES "${SECONDS} * 1000000 + ${MICROSECONDS}")
+  set(${OUT} ${RES} PARENT_SCOPE)
+endfunction()
+
+# Returns the summed size of the .text* sections of an object file.
+function(text_size OBJECT OUT)
+  execute_process(COMMAND "${SIZE}" -A "${OBJECT}" OUTPUT_VARIABLE SECTIONS)
+  string(REGEX MATCHALL "\n\\.text[^ \t]*[ \t]+[0-9]+" TEXTS "${SECTIONS}")
+  set(RES 0)
+  foreach(TEXT ${TEXTS})
+    string(REGEX REPLACE ".*[ \t]([0-9]+)$" "\\1" BYTES "${TEXT}")
+    math(EXPR RES "${RES} + ${BYTES}")
+  endforeach()
+  set(${OUT} ${RES} PARENT_SCOPE)
+endfunction()
+
+# Returns the number of distinct dbc::details::rhs_decomposer functions defined in an object file.
+function(decomposer_count OBJECT OUT)
+  execute_process(COMMAND "${NM}" -C --defined-only "${OBJECT}" OUTPUT_VARIABLE SYMBOLS)
+  string(REGEX MATCHALL "dbc::details::rhs_decomposer[^\n]*" FOUND "${SYMBOLS}")
+  list(REMOVE_DUPLICATES FOUND)
+  list(LENGTH FOUND RES)
+  set(${OUT} ${RES} PARENT_SCOPE)
+endfunction()
+
+# Returns a value padded to the given width, right aligned, or left aligned if width is negative.
+function(pad VALUE WIDTH OUT)
+  string(LENGTH "${VALUE}" LENGTH)
+  if(WIDTH LESS 0)
+    math(EXPR COUNT "-(${WIDTH}) - ${LENGTH}")
+  else()
+    math(EXPR COUNT "${WIDTH} - ${LENGTH}")
+  endif()
+  set(SPACES "")
+  if(COUNT GREATER 0)
+    string(REPEAT " " ${COUNT} SPACES)
+  endif()
+  if(WIDTH LESS 0)
+    set(${OUT} "${VALUE}${SPACES}" PARENT_SCOPE)
+  else()
+    set(${OUT} "${SPACES}${VALUE}" PARENT_SCOPE)
+  endif()
+endfunction()
+
+# Appends a table row of values, padded to the given widths, to a variable.
+function(append_row OUT VALUES WIDTHS)
+  set(ROW "")
+  foreach(VALUE WIDTH IN ZIP_LISTS VALUES WIDTHS)
+    pad("${VALUE}" ${WIDTH} CELL)
+    string(APPEND ROW "${CELL}")
+  endforeach()
+  set(${OUT} "${${OUT}}${ROW}\n" PARENT_SCOPE)
+endfunction()
+
+set(LEVELS NONE PRECONDITIONS POSTCONDITIONS INVARIANTS)
+set(WIDTHS -16 12 12 14 13 13)
+
+set(TABLE "dbc codegen report: ${SITES} sites (${FUNCTIONS} functions), flags: ${CXX_FLAGS}\n")
+string(APPEND TABLE "decomposers: distinct rhs_decomposer functions instantiated (at -O0)\n\n")
+append_row(TABLE "level;object(B);text(B);text/site(B);decomposers;compile(ms)" "${WIDTHS}")
+
+foreach(LEVEL ${LEVELS})
+  set(OBJECT "${OUTPUT_DIR}/dbc_codegen_${LEVEL}.o")
+  set(COMMAND "${CXX}" -std=c++20 -DDBC_ASSERT_LEVEL_${LEVEL} -I "${INCLUDE_DIR}" -c "${SOURCE}")
+
+  now_us(START)
+  execute_process(
+    COMMAND ${COMMAND} ${CXX_FLAGS} -o "${OBJECT}" RESULT_VARIABLE FAILED ERROR_VARIABLE ERRORS)
+  now_us(STOP)
+
+  if(FAILED)
+    message(FATAL_ERROR "dbc_codegen_report: ${LEVEL} compilation failed:\n${ERRORS}")
+  endif()
+
+  math(EXPR MS "(${STOP} - ${START}) / 1000")
+  file(SIZE "${OBJECT}" OBJECT_SIZE)
+  text_size("${OBJECT}" TEXT)
+  math(EXPR PER_SITE "${TEXT} / ${SITES}")
+
+  # Optimized objects inline most instantiations away, thus count them on an unoptimized one.
+  execute_process(COMMAND ${COMMAND} -O0 -o "${OBJECT}.O0" RESULT_VARIABLE FAILED)
+  if(FAILED)
+    message(FATAL_ERROR "dbc_codegen_report: ${LEVEL} -O0 compilation failed")
+  endif()
+  decomposer_count("${OBJECT}.O0" DECOMPOSERS)
+
+  append_row(TABLE "${LEVEL};${OBJECT_SIZE};${TEXT};${PER_SITE};${DECOMPOSERS};${MS}" "${WIDTHS}")
+endforeach()
+
+set(REPORT "${OUTPUT_DIR}/dbc_codegen_report.txt")
+file(WRITE "${REPORT}" "${TABLE}")
+message("${TABLE}\nWritten to: ${REPORT}")
@@ -26,7 +26,7 @@
 
 #define DBC_ASSERT_LEVEL_POSTCONDITIONS
 
-#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
 #include <iostream>
 
 // showcase of DBC working with defensive programming.
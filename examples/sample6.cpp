@@ -26,6 +26,7 @@
 
 #define DBC_ASSERT_LEVEL_POSTCONDITIONS
 
+#include "dbc/class_invariant.hpp"
 #include "dbc/dbc.hpp"
 #include <algorithm>
 #include <set>
@@ -50,8 +51,8 @@ public:
 
     auto get(const Tag& tag) const -> const Resource&
     {
-        DBC_INVARIANT(!has_duplicate<Tag>(std::begin(registry), std::end(registry)));
-        DBC_REQUIRE(contains(tag), "Did not find tag: " + std::to_string(tag));
+        DBC_INVARIANT_GUARD(!has_duplicate<Tag>(std::begin(registry), std::end(registry)));
+        DBC_REQUIRE(contains(tag), "Did not find tag: {}", tag);
         DBC_ENSURE(registry.at(tag));
         return *registry.at(tag);
     }
@@ -63,11 +64,11 @@ public:
 
     void insert(const Tag& tag)
     {
-        DBC_INVARIANT(!has_duplicate<Tag>(std::begin(registry), std::end(registry)));
+        // Checked on entry and exit of the outermost call only.
+        DBC_INVARIANT_GUARD(!has_duplicate<Tag>(std::begin(registry), std::end(registry)));
         DBC_REQUIRE(!contains(tag));
         registry[tag] = factory(tag);
         DBC_ENSURE(contains(tag));
-        DBC_INVARIANT(!has_duplicate<Tag>(std::begin(registry), std::end(registry)));
     }
 
 private:
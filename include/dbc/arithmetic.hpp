@@ -0,0 +1,244 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_ARITHMETIC_H
+#define DBC_ARITHMETIC_H
+
+#include "dbc/dbc.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "dbc/arithmetic.hpp requires the __builtin_*_overflow builtins (GCC or Clang)"
+#endif
+
+// PURPOSE: Provide overflow checked integer arithmetic, as precondition expressions, that compile
+// to the operation and a branch on the overflow flag. Macros: DBC_CHECKED_ADD, DBC_CHECKED_SUB,
+// DBC_CHECKED_MUL, DBC_CHECKED_CAST
+
+namespace dbc::details
+{
+
+// Returns the name of an integer type, for the decompositions.
+/// @private
+template <typename T>
+constexpr auto integer_name() noexcept -> std::string_view
+{
+    using namespace std::string_view_literals;
+
+    // clang-format off
+    if constexpr (std::is_same_v<T, char>) return "char"sv;
+    else if constexpr (std::is_same_v<T, signed char>) return "signed char"sv;
+    else if constexpr (std::is_same_v<T, unsigned char>) return "unsigned char"sv;
+    else if constexpr (std::is_same_v<T, short>) return "short"sv;
+    else if constexpr (std::is_same_v<T, unsigned short>) return "unsigned short"sv;
+    else if constexpr (std::is_same_v<T, int>) return "int"sv;
+    else if constexpr (std::is_same_v<T, unsigned>) return "unsigned int"sv;
+    else if constexpr (std::is_same_v<T, long>) return "long"sv;
+    else if constexpr (std::is_same_v<T, unsigned long>) return "unsigned long"sv;
+    else if constexpr (std::is_same_v<T, long long>) return "long long"sv;
+    else if constexpr (std::is_same_v<T, unsigned long long>) return "unsigned long long"sv;
+    else return "integer"sv;
+    // clang-format on
+}
+
+// The overflow builtins reject bool.
+/// @private
+template <typename T>
+concept checked_integer = std::is_integral_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+// The wrapped result of an operation, and whether the exact result overflowed it.
+/// @private
+template <typename T>
+struct overflow_result
+{
+    T wrapped;
+    bool overflow;
+};
+
+/// @private
+template <checked_integer T, checked_integer U>
+constexpr auto overflowing_add(T lhs, U rhs) noexcept
+{
+    overflow_result<decltype(lhs + rhs)> result{};
+    result.overflow = __builtin_add_overflow(lhs, rhs, &result.wrapped);
+    return result;
+}
+
+/// @private
+template <checked_integer T, checked_integer U>
+constexpr auto overflowing_sub(T lhs, U rhs) noexcept
+{
+    overflow_result<decltype(lhs - rhs)> result{};
+    result.overflow = __builtin_sub_overflow(lhs, rhs, &result.wrapped);
+    return result;
+}
+
+/// @private
+template <checked_integer T, checked_integer U>
+constexpr auto overflowing_mul(T lhs, U rhs) noexcept
+{
+    overflow_result<decltype(lhs * rhs)> result{};
+    result.overflow = __builtin_mul_overflow(lhs, rhs, &result.wrapped);
+    return result;
+}
+
+/// @private
+template <checked_integer To, checked_integer From>
+constexpr auto overflowing_cast(From value) noexcept
+{
+    overflow_result<To> result{};
+    result.overflow = __builtin_add_overflow(value, 0, &result.wrapped); // exact, or overflows
+    return result;
+}
+
+// Passed by value, not as a violation_site reference, so that the compiler can sink it into the
+// cold path, rather than building it in memory for every operation.
+/// @private
+struct arithmetic_site
+{
+    const char* condition;
+    const char* function;
+    const char* file;
+    int line;
+};
+
+// Reports an overflow, with the operands and the result type in the decomposition.
+/// @private
+template <typename Result, typename T, typename U>
+DBC_COLD void fail_arithmetic(arithmetic_site site, T lhs, std::string_view op, U rhs)
+{
+    auto decomposition = std::to_string(+lhs);
+    decomposition.append(op).append(std::to_string(+rhs)).append(" overflows ");
+    decomposition.append(integer_name<Result>());
+
+    handle(make_context(contract::precondition, site.condition, decomposition, site.function,
+                        site.file, site.line, ""));
+}
+
+/// @private
+template <typename Result, typename T>
+DBC_COLD void fail_cast(arithmetic_site site, T value)
+{
+    auto decomposition = std::to_string(+value);
+    decomposition.append(" overflows ").append(integer_name<Result>());
+
+    handle(make_context(contract::precondition, site.condition, decomposition, site.function,
+                        site.file, site.line, ""));
+}
+
+// The name of the function of a checked operation, as a type, since the operation is checked in a
+// lambda, whose own __FUNCTION__ is operator(), and the site toggle requires a constant name.
+/// @private
+template <std::size_t N>
+struct function_name
+{
+    consteval function_name(const char (&name)[N]) noexcept { std::copy_n(name, N, value); }
+
+    char value[N];
+};
+
+/// @private
+template <function_name Name>
+struct site_function
+{
+    static constexpr const char* name = Name.value;
+};
+
+} // namespace dbc::details
+
+#define DBC_ARITHMETIC_SITE(condition, function)                                                   \
+    dbc::details::arithmetic_site                                                                  \
+    {                                                                                              \
+        condition, function, __FILE__, __LINE__                                                    \
+    }
+
+// Checks an operation on the common path of the assertions, in an immediately invoked lambda, so
+// that the macros remain expressions. The result is computed even if the site is disabled.
+#define DBC_CHECKED_IMPL(operation, op, lhs, rhs)                                                  \
+    [](auto dbc_lhs, auto dbc_rhs, auto dbc_function) {                                            \
+        DBC_SITE_CONDITION(dbc_condition, #lhs " " op " " #rhs);                                   \
+        const auto dbc_result = dbc::details::operation(dbc_lhs, dbc_rhs);                         \
+        DBC_CHECK_AT_IMPL(dbc::contract::precondition, decltype(dbc_function)::name,              \
+                          dbc_condition, !dbc_result.overflow,                                     \
+                          dbc::details::fail_arithmetic<decltype(dbc_result.wrapped)>(               \
+                              DBC_ARITHMETIC_SITE(dbc_condition, decltype(dbc_function)::name),   \
+                              dbc_lhs, " " op " ", dbc_rhs))                                       \
+        return dbc_result.wrapped;                                                                   \
+    }((lhs), (rhs), dbc::details::site_function<__FUNCTION__>{})
+
+#if DBC_PRECONDITIONS_ENABLED
+
+/**
+ * @def DBC_CHECKED_ADD(lhs, rhs)
+ *  Evaluates to lhs + rhs, of the type of lhs + rhs, requiring that it does not overflow. On
+ *  violation, the operands and the result type are reported in the decomposition, and the wrapped
+ *  result is returned, if the handler returns.
+ */
+#define DBC_CHECKED_ADD(lhs, rhs) DBC_CHECKED_IMPL(overflowing_add, "+", lhs, rhs)
+
+/**
+ * @def DBC_CHECKED_SUB(lhs, rhs)
+ *  Evaluates to lhs - rhs, of the type of lhs - rhs, requiring that it does not overflow.
+ */
+#define DBC_CHECKED_SUB(lhs, rhs) DBC_CHECKED_IMPL(overflowing_sub, "-", lhs, rhs)
+
+/**
+ * @def DBC_CHECKED_MUL(lhs, rhs)
+ *  Evaluates to lhs * rhs, of the type of lhs * rhs, requiring that it does not overflow.
+ */
+#define DBC_CHECKED_MUL(lhs, rhs) DBC_CHECKED_IMPL(overflowing_mul, "*", lhs, rhs)
+
+/**
+ * @def DBC_CHECKED_CAST(type, value)
+ *  Evaluates to static_cast<type>(value), requiring that the value is representable in the type.
+ */
+#define DBC_CHECKED_CAST(type, value)                                                              \
+    [](auto dbc_value, auto dbc_function) {                                                        \
+        DBC_SITE_CONDITION(dbc_condition, "static_cast<" #type ">(" #value ")");                   \
+        const auto dbc_result = dbc::details::overflowing_cast<type>(dbc_value);                   \
+        DBC_CHECK_AT_IMPL(dbc::contract::precondition, decltype(dbc_function)::name,              \
+                          dbc_condition, !dbc_result.overflow,                                     \
+                          dbc::details::fail_cast<type>(                                           \
+                              DBC_ARITHMETIC_SITE(dbc_condition, decltype(dbc_function)::name),   \
+                              dbc_value))                                                          \
+        return dbc_result.wrapped;                                                                   \
+    }((value), dbc::details::site_function<__FUNCTION__>{})
+
+#else
+
+// Wrap on overflow, as when checked, rather than overflowing signed integers, which is undefined.
+#define DBC_CHECKED_ADD(lhs, rhs) (dbc::details::overflowing_add((lhs), (rhs)).wrapped)
+#define DBC_CHECKED_SUB(lhs, rhs) (dbc::details::overflowing_sub((lhs), (rhs)).wrapped)
+#define DBC_CHECKED_MUL(lhs, rhs) (dbc::details::overflowing_mul((lhs), (rhs)).wrapped)
+#define DBC_CHECKED_CAST(type, value) static_cast<type>(value)
+
+#endif
+
+#endif // DBC_ARITHMETIC_H
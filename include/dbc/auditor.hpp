@@ -0,0 +1,425 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_AUDITOR_H
+#define DBC_AUDITOR_H
+
+#include "dbc/handlers.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <source_location>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// PURPOSE: Provide a background thread, that periodically re-checks the invariants of registered,
+// long-lived, objects, e.g. caches and registries, off the request path.
+
+namespace dbc
+{
+
+/** @defgroup auditing Auditing
+ *  @{
+ */
+
+class auditor;
+
+namespace details
+{
+    /// @private
+    struct audit_description
+    {
+        std::shared_ptr<const std::string> description;
+    };
+
+    // A violation of an audit, that owns the description its condition refers to, so that a kept
+    // handler exception outlives the unwatched audit.
+    /// @private
+    class audit_violation : private audit_description, public contract_violation
+    {
+    public:
+        audit_violation(std::shared_ptr<const std::string> description, violation_context context)
+            : audit_description{std::move(description)},
+              contract_violation{with_condition(std::move(context), *this->description)}
+        {}
+
+    private:
+        static auto with_condition(violation_context context, std::string_view condition)
+            -> violation_context
+        {
+            context.condition = condition;
+            return context;
+        }
+    };
+
+} // namespace details
+
+/**
+ * @brief The registration of an audit to a dbc::auditor. Unwatches the audit on destruction.
+ *
+ */
+DBC_API class audit_handle
+{
+public:
+    audit_handle() noexcept = default;
+    audit_handle(auditor& owner, std::uint64_t id) noexcept : m_owner{&owner}, m_id{id} {}
+
+    audit_handle(audit_handle&& other) noexcept
+        : m_owner{std::exchange(other.m_owner, nullptr)}, m_id{other.m_id}
+    {}
+
+    auto operator=(audit_handle&& other) -> audit_handle&
+    {
+        if (this != &other)
+        {
+            reset();
+            m_owner = std::exchange(other.m_owner, nullptr);
+            m_id = other.m_id;
+        }
+        return *this;
+    }
+
+    audit_handle(const audit_handle&) = delete;
+    auto operator=(const audit_handle&) -> audit_handle& = delete;
+
+    ~audit_handle() { reset(); }
+
+    /**
+     * @brief Unwatches the audit, waiting for it to finish if currently running.
+     *
+     * @throws std::system_error if locking the auditor fails, in which case the destructor
+     * terminates
+     */
+    void reset(); // defined after the auditor
+
+private:
+    auditor* m_owner{nullptr};
+    std::uint64_t m_id{0};
+};
+
+/**
+ * @brief A low-priority background thread, that periodically re-checks the registered audits.
+ *
+ * An audit is a callback, that either returns whether the invariants of an object hold, or checks
+ * them with DBC_INVARIANT assertions. A false result is reported to the set violation handler, as
+ * an invariant violation, at the site where the audit was registered. Audits are not affected by
+ * the assert level, so that invariant checks can be turned off inline, and audited instead.
+ *
+ * Audits run on the auditor thread, thus must synchronize with the audited objects, e.g. through
+ * the lock overload of watch, or by checking a snapshot of them. Exceptions thrown from the audits,
+ * or from the violation handler (e.g. dbc::throw_handler), are caught, so that they do not
+ * terminate the thread. The last one is available through last_error. The audits and the handler
+ * run without holding the auditor lock, thus may watch and unwatch other audits, but an audit
+ * must not unwatch itself, as unwatching waits for it to finish.
+ *
+ */
+DBC_API class auditor
+{
+public:
+    /**
+     * @brief Starts the auditor thread, at the lowest scheduling priority where supported.
+     *
+     * @param period the time between two audit passes
+     */
+    explicit auditor(std::chrono::milliseconds period = std::chrono::seconds{1})
+        : m_period{period}, m_thread{[this](std::stop_token token) { run(token); }}
+    {
+#if defined(__linux__)
+        const sched_param param{0};
+        pthread_setschedparam(m_thread.native_handle(), SCHED_IDLE, &param);
+#endif
+    }
+
+    auditor(const auditor&) = delete;
+    auditor(auditor&&) = delete;
+
+    auto operator=(const auditor&) -> auditor& = delete;
+    auto operator=(auditor&&) -> auditor& = delete;
+
+    ~auditor()
+    {
+        m_thread.request_stop();
+        m_thread.join();
+    }
+
+    /**
+     * @brief Registers an audit.
+     *
+     * @param audit a callback, returning a bool, true if the invariants hold, or void, checking
+     * them with DBC_INVARIANT assertions
+     * @param description the description of the audit, reported as the violated condition
+     * @param where the registration site, reported as the violation site
+     *
+     * @return the registration of the audit, which unwatches it on destruction
+     */
+    template <std::invocable Audit>
+    [[nodiscard]] auto watch(Audit audit, std::string_view description = "audit",
+                             std::source_location where = std::source_location::current())
+        -> audit_handle
+    {
+        std::function<bool()> run;
+        if constexpr (std::is_void_v<std::invoke_result_t<Audit&>>)
+            run = [audit = std::move(audit)]() mutable { return audit(), true; };
+        else
+            run = [audit = std::move(audit)]() mutable { return static_cast<bool>(audit()); };
+
+        std::scoped_lock lock{m_mutex};
+        m_audits.push_back(
+            std::make_shared<entry>(++m_last_id, std::move(run),
+                                    std::make_shared<const std::string>(description), where));
+        return {*this, m_last_id};
+    }
+
+    /**
+     * @brief Registers an audit, that runs while holding a lock of a mutex. Shared mutexes are
+     * locked in shared mode.
+     *
+     * @see dbc::auditor::watch
+     *
+     * @param mutex the mutex which guards the audited object
+     * @param audit a callback, returning a bool or void
+     * @param description the description of the audit, reported as the violated condition
+     * @param where the registration site, reported as the violation site
+     *
+     * @return the registration of the audit, which unwatches it on destruction
+     */
+    template <typename Mutex, std::invocable Audit>
+    [[nodiscard]] auto watch(Mutex& mutex, Audit audit, std::string_view description = "audit",
+                             std::source_location where = std::source_location::current())
+        -> audit_handle
+    {
+        return watch(
+            [&mutex, audit = std::move(audit)]() mutable {
+                if constexpr (requires { mutex.lock_shared(); })
+                {
+                    std::shared_lock lock{mutex};
+                    return audit();
+                }
+                else
+                {
+                    std::scoped_lock lock{mutex};
+                    return audit();
+                }
+            },
+            description, where);
+    }
+
+    /**
+     * @brief Registers an audit, that checks a snapshot of an object, e.g. a copy taken under a
+     * lock, so that the audited object is not blocked while being checked.
+     *
+     * @see dbc::auditor::watch
+     *
+     * @param snapshot a callback, returning the snapshot
+     * @param check a callback, accepting the snapshot, returning a bool or void
+     * @param description the description of the audit, reported as the violated condition
+     * @param where the registration site, reported as the violation site
+     *
+     * @return the registration of the audit, which unwatches it on destruction
+     */
+    template <std::invocable Snapshot, std::invocable<std::invoke_result_t<Snapshot&>> Check>
+    [[nodiscard]] auto watch_snapshot(Snapshot snapshot, Check check,
+                                      std::string_view description = "audit",
+                                      std::source_location where = std::source_location::current())
+        -> audit_handle
+    {
+        return watch([snapshot = std::move(snapshot),
+                      check = std::move(check)]() mutable { return check(snapshot()); },
+                     description, where);
+    }
+
+    /**
+     * @brief Unregisters an audit, waiting for it to finish if currently running.
+     *
+     * @param id the id of the audit registration
+     *
+     * @throws std::system_error if locking fails
+     */
+    void unwatch(std::uint64_t id)
+    {
+        std::shared_ptr<entry> unwatched;
+
+        {
+            std::scoped_lock lock{m_mutex};
+            const auto iter = std::find_if(std::begin(m_audits), std::end(m_audits),
+                                           [id](const auto& e) { return e->id == id; });
+            if (iter == std::end(m_audits)) return;
+
+            unwatched = std::move(*iter);
+            m_audits.erase(iter);
+        }
+
+        std::scoped_lock lock{unwatched->run_mutex}; // waits for a running pass of this audit
+        unwatched->watched = false;
+    }
+
+    /**
+     * @brief Runs all the audits once, on the calling thread.
+     *
+     */
+    void audit() { audit_all(); }
+
+    /**
+     * @brief Returns the number of completed audit passes, of the auditor thread.
+     *
+     * @return the number of completed audit passes
+     */
+    auto passes() const noexcept -> std::uint64_t
+    {
+        return m_passes.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns the last exception thrown from an audit or the violation handler, if any.
+     *
+     * @return the last exception, or nullptr
+     */
+    auto last_error() const -> std::exception_ptr
+    {
+        std::scoped_lock lock{m_mutex};
+        return m_last_error;
+    }
+
+private:
+    // An audit, shared with the passes that run it, so that they do not hold the auditor mutex.
+    struct entry
+    {
+        entry(std::uint64_t id, std::function<bool()> run,
+              std::shared_ptr<const std::string> description, std::source_location where)
+            : id{id}, run{std::move(run)}, description{std::move(description)}, where{where}
+        {}
+
+        std::uint64_t id;
+        std::function<bool()> run;
+        std::shared_ptr<const std::string> description; // shared with the kept violations
+        std::source_location where;
+        std::mutex run_mutex; // held while running
+        bool watched{true};
+    };
+
+    // Runs the audits of a snapshot of the registrations, without holding the auditor mutex, and
+    // handles their failures without holding their run mutex either, so that watch and unwatch
+    // only wait for a running audit of their own.
+    void audit_all()
+    {
+        std::vector<std::shared_ptr<entry>> audits;
+
+        {
+            std::scoped_lock lock{m_mutex};
+            audits = m_audits;
+        }
+
+        for (const auto& e : audits)
+        {
+            try
+            {
+                bool held{true};
+
+                {
+                    std::scoped_lock lock{e->run_mutex};
+                    if (e->watched) held = e->run();
+                }
+
+                if (!held)
+                {
+                    details::handle(details::make_context(
+                        contract::invariant, *e->description, {}, e->where.function_name(),
+                        e->where.file_name(), static_cast<int32_t>(e->where.line()),
+                        "Background audit failed"));
+                }
+            } catch (const contract_violation& v)
+            {
+                // E.g. from dbc::throw_handler, whose condition refers to the audit description.
+                if (v.context().condition.data() == e->description->data())
+                    keep(std::make_exception_ptr(
+                        details::audit_violation{e->description, v.context()}));
+                else
+                    keep(std::current_exception());
+            } catch (...)
+            {
+                keep(std::current_exception());
+            }
+        }
+    }
+
+    void keep(std::exception_ptr error)
+    {
+        std::scoped_lock lock{m_mutex};
+        m_last_error = std::move(error);
+    }
+
+    void run(std::stop_token token)
+    {
+        while (!token.stop_requested())
+        {
+            {
+                std::unique_lock lock{m_mutex};
+                m_wakeup.wait_for(lock, token, m_period, [] { return false; }); // woken by stop
+            }
+            if (token.stop_requested()) break;
+
+            audit_all();
+            m_passes.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    std::chrono::milliseconds m_period;
+    mutable std::mutex m_mutex;
+    std::condition_variable_any m_wakeup;
+    std::vector<std::shared_ptr<entry>> m_audits;
+    std::uint64_t m_last_id{0};
+    std::exception_ptr m_last_error;
+    std::atomic<std::uint64_t> m_passes{0};
+    std::jthread m_thread; // last, started after the rest are initialized
+};
+
+inline void audit_handle::reset()
+{
+    if (m_owner) std::exchange(m_owner, nullptr)->unwatch(m_id);
+}
+
+/** @} */
+
+} // namespace dbc
+
+#endif // DBC_AUDITOR_H
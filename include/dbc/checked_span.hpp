@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_CHECKED_SPAN_H
+#define DBC_CHECKED_SPAN_H
+
+#include "dbc/dbc.hpp"
+#include "dbc/memory.hpp"
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+// PURPOSE: Provide a span, whose element access is bounds checked with preconditions, but whose
+// iteration and sub-span APIs verify bounds once per range, so that loops over it run unchecked.
+
+namespace dbc
+{
+
+/** @defgroup checked_span Checked Span
+ *  @{
+ */
+
+// The inline member functions of a checked span expand their preconditions per assert level. Each
+// level gets its own namespace, thus its own type, so that translation units built with different
+// levels do not define the same functions differently.
+#if DBC_PRECONDITIONS_ENABLED
+inline namespace checked_preconditions
+{
+#else
+inline namespace unchecked_preconditions
+{
+#endif
+
+/**
+ * @brief A std::span adapter, with precondition checked element access.
+ *
+ * Indexing, front and back check their bounds per access, with DBC_REQUIRE_IN_BOUNDS. The
+ * sub-span APIs (first, last, subspan) check their bounds once, and return checked spans. The
+ * iterators are raw pointers, in bounds by construction, thus range-based loops over a checked
+ * span cost the same as over a std::span.
+ *
+ * @tparam T the element type
+ * @tparam Extent the number of elements, or std::dynamic_extent
+ */
+template <typename T, std::size_t Extent = std::dynamic_extent>
+DBC_API class checked_span
+{
+public:
+    using span_type = std::span<T, Extent>;
+    using element_type = typename span_type::element_type;
+    using value_type = typename span_type::value_type;
+    using size_type = typename span_type::size_type;
+    using difference_type = typename span_type::difference_type;
+    using pointer = typename span_type::pointer;
+    using const_pointer = typename span_type::const_pointer;
+    using reference = typename span_type::reference;
+    using const_reference = typename span_type::const_reference;
+    using iterator = pointer;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    static constexpr std::size_t extent = Extent;
+
+    constexpr checked_span() noexcept
+        requires(Extent == std::dynamic_extent || Extent == 0)
+    = default;
+
+    constexpr checked_span(span_type span) noexcept : m_span{span} {}
+
+    template <typename U, std::size_t N>
+        requires std::is_constructible_v<span_type, std::span<U, N>>
+    constexpr explicit(Extent != std::dynamic_extent && N == std::dynamic_extent)
+        checked_span(checked_span<U, N> other) noexcept
+        : m_span{other.unchecked()}
+    {}
+
+    template <typename R>
+        requires std::is_constructible_v<span_type, R&&> &&
+                 (!std::is_same_v<std::remove_cvref_t<R>, checked_span>)
+    constexpr explicit(Extent != std::dynamic_extent) checked_span(R&& range)
+        : m_span{std::forward<R>(range)}
+    {}
+
+    /**
+     * @brief Constructs a checked span over [first, first + count).
+     *
+     * @param first the first element
+     * @param count the number of elements, must equal Extent if static
+     */
+    checked_span(pointer first, size_type count) : m_span{check_extent(first, count), count} {}
+
+    constexpr auto begin() const noexcept -> iterator { return m_span.data(); }
+    constexpr auto end() const noexcept -> iterator { return m_span.data() + m_span.size(); }
+    constexpr auto rbegin() const noexcept -> reverse_iterator { return reverse_iterator{end()}; }
+    constexpr auto rend() const noexcept -> reverse_iterator { return reverse_iterator{begin()}; }
+
+    constexpr auto data() const noexcept -> pointer { return m_span.data(); }
+    constexpr auto size() const noexcept -> size_type { return m_span.size(); }
+    constexpr auto size_bytes() const noexcept -> size_type { return m_span.size_bytes(); }
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_span.empty(); }
+
+    /**
+     * @brief Accesses an element, requiring that 0 <= index < size().
+     *
+     */
+    auto operator[](size_type index) const -> reference
+    {
+        DBC_REQUIRE_IN_BOUNDS(index, size());
+        return m_span[index];
+    }
+
+    /**
+     * @brief Accesses the first element, requiring that the span is not empty.
+     *
+     */
+    auto front() const -> reference
+    {
+        DBC_REQUIRE(!empty(), "front() of an empty span");
+        return m_span.front();
+    }
+
+    /**
+     * @brief Accesses the last element, requiring that the span is not empty.
+     *
+     */
+    auto back() const -> reference
+    {
+        DBC_REQUIRE(!empty(), "back() of an empty span");
+        return m_span.back();
+    }
+
+    /**
+     * @brief Returns the first count elements, requiring that count <= size().
+     *
+     */
+    auto first(size_type count) const -> checked_span<T>
+    {
+        DBC_REQUIRE(count <= size());
+        return m_span.first(count);
+    }
+
+    /**
+     * @brief Returns the last count elements, requiring that count <= size().
+     *
+     */
+    auto last(size_type count) const -> checked_span<T>
+    {
+        DBC_REQUIRE(count <= size());
+        return m_span.last(count);
+    }
+
+    /**
+     * @brief Returns count elements, from offset on, or the rest of them if count is
+     * std::dynamic_extent, requiring that offset <= size() and offset + count <= size().
+     *
+     */
+    auto subspan(size_type offset, size_type count = std::dynamic_extent) const -> checked_span<T>
+    {
+        DBC_REQUIRE(offset <= size());
+        DBC_REQUIRE((count == std::dynamic_extent || count <= size() - offset));
+        return m_span.subspan(offset, count);
+    }
+
+    /**
+     * @brief Returns the underlying, unchecked, std::span.
+     *
+     */
+    constexpr auto unchecked() const noexcept -> span_type { return m_span; }
+
+    constexpr operator span_type() const noexcept { return m_span; }
+
+private:
+    static auto check_extent(pointer first, [[maybe_unused]] size_type count) -> pointer
+    {
+        if constexpr (Extent != std::dynamic_extent) DBC_REQUIRE(count == Extent);
+        return first;
+    }
+
+    span_type m_span;
+};
+
+template <typename T, std::size_t N>
+checked_span(T (&)[N]) -> checked_span<T, N>;
+
+template <typename T, std::size_t N>
+checked_span(std::array<T, N>&) -> checked_span<T, N>;
+
+template <typename T, std::size_t N>
+checked_span(const std::array<T, N>&) -> checked_span<const T, N>;
+
+template <std::ranges::contiguous_range R>
+checked_span(R&&) -> checked_span<std::remove_reference_t<std::ranges::range_reference_t<R>>>;
+
+template <typename T>
+checked_span(T*, std::size_t) -> checked_span<T>;
+
+} // namespace checked_preconditions, or unchecked_preconditions
+
+/** @} */
+
+} // namespace dbc
+
+namespace std::ranges
+{
+
+template <typename T, std::size_t Extent>
+inline constexpr bool enable_borrowed_range<dbc::checked_span<T, Extent>> = true;
+
+template <typename T, std::size_t Extent>
+inline constexpr bool enable_view<dbc::checked_span<T, Extent>> = true;
+
+} // namespace std::ranges
+
+#endif // DBC_CHECKED_SPAN_H
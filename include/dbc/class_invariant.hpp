@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_CLASS_INVARIANT_H
+#define DBC_CLASS_INVARIANT_H
+
+#include "dbc/dbc.hpp"
+#include <cstddef>
+#include <exception>
+
+// PURPOSE: Provide a class invariant guard, that checks the invariants of an object on entry and
+// exit of only the outermost public member function call, instead of on every nested call.
+// Macros: DBC_INVARIANT_GUARD
+
+namespace dbc::details
+{
+
+// The objects whose invariant guards are active on a thread, outermost first.
+/// @private
+struct invariant_frames
+{
+    static constexpr std::size_t capacity = 16;
+
+    const void* objects[capacity];
+    std::size_t size;
+};
+
+/// @private
+inline auto active_invariants() noexcept -> invariant_frames&
+{
+    static thread_local constinit invariant_frames frames{{}, 0};
+    return frames;
+}
+
+// Checks the invariants of an object on construction and destruction, unless a guard of the same
+// object is already active on this thread. Past the frames capacity, guards always check. The
+// check reports its own violations, on the common path of the assertions of its site.
+/// @private
+template <typename Check>
+class invariant_guard
+{
+public:
+    invariant_guard(const void* object, Check check) : m_check{check}
+    {
+        auto& frames = active_invariants();
+
+        for (std::size_t i = 0; i < frames.size; ++i)
+            if (frames.objects[i] == object) return; // nested
+
+        m_outermost = true;
+        m_exceptions = std::uncaught_exceptions();
+
+        if (frames.size < invariant_frames::capacity)
+        {
+            frames.objects[frames.size++] = object;
+            m_pushed = true;
+        }
+
+        // Pushed before the check, for the invariant to call guarded members, thus popped if it
+        // throws, as this guard is never destroyed then.
+        try
+        {
+            m_check();
+        } catch (...)
+        {
+            if (m_pushed) --frames.size;
+            throw;
+        }
+    }
+
+    invariant_guard(const invariant_guard&) = delete;
+    invariant_guard(invariant_guard&&) = delete;
+
+    auto operator=(const invariant_guard&) -> invariant_guard& = delete;
+    auto operator=(invariant_guard&&) -> invariant_guard& = delete;
+
+    // Not checked when unwinding, as the handler might throw.
+    ~invariant_guard() noexcept(false)
+    {
+        if (!m_outermost) return;
+        if (m_pushed) --active_invariants().size;
+        if (std::uncaught_exceptions() == m_exceptions) m_check();
+    }
+
+private:
+    Check m_check;
+    bool m_outermost{false};
+    bool m_pushed{false};
+    int m_exceptions{0};
+};
+
+} // namespace dbc::details
+
+#define DBC_INVARIANT_CONCAT_IMPL(x, y) x##y
+#define DBC_INVARIANT_CONCAT(x, y) DBC_INVARIANT_CONCAT_IMPL(x, y)
+
+#if DBC_INVARIANTS_ENABLED
+
+// The check runs in a lambda, whose own __FUNCTION__ is operator(), thus it is given the name of
+// the guarded member function.
+#define DBC_INVARIANT_GUARD_IMPL(expr, msg)                                                        \
+    static constexpr const char* DBC_INVARIANT_CONCAT(dbc_invariant_function, __LINE__) =          \
+        __FUNCTION__;                                                                              \
+    const dbc::details::invariant_guard DBC_INVARIANT_CONCAT(dbc_invariant_guard, __LINE__)        \
+    {                                                                                              \
+        this, [&] {                                                                                \
+            constexpr auto dbc_function = DBC_INVARIANT_CONCAT(dbc_invariant_function, __LINE__);  \
+            DBC_SITE_CONDITION(dbc_condition, #expr);                                              \
+            DBC_CHECK_AT_IMPL(dbc::contract::invariant, dbc_function, dbc_condition, expr,         \
+                              dbc::details::handle(dbc::details::make_context(                     \
+                                  dbc::contract::invariant, dbc_condition, DBC_DECOMPOSE(expr),    \
+                                  dbc_function, __FILE__, __LINE__, msg)))                         \
+        }                                                                                          \
+    }
+
+#define DBC_INVARIANT_GUARD1(expr) DBC_INVARIANT_GUARD_IMPL(expr, "")
+#define DBC_INVARIANT_GUARD2(expr, ...) DBC_INVARIANT_GUARD_IMPL(expr, DBC_MESSAGE(__VA_ARGS__))
+
+#else
+
+#define DBC_INVARIANT_GUARD1(expr) DBC_UNCHECKED(expr)
+#define DBC_INVARIANT_GUARD2(expr, ...) DBC_UNCHECKED(expr)
+
+#endif
+
+/**
+ * @def DBC_INVARIANT_GUARD(expr [, message, args...])
+ *  Checks the class invariant expr on entry and exit of a member function, only if it is the
+ *  outermost guarded call on this object and thread, thus public member functions calling each
+ *  other check the invariant once on entry, and once on exit. The exit check is skipped when
+ *  unwinding from an exception. As with DBC_INVARIANT, the message can be a format string, whose
+ *  arguments are formatted on a violation, and the site shares the toggles, tracepoints and shared
+ *  stats of the other assertions. Compiles to DBC_UNCHECKED(expr) when invariants are disabled.
+ */
+#define DBC_INVARIANT_GUARD(...) DBC_SELECT_MESSAGE_MACRO(DBC_INVARIANT_GUARD, __VA_ARGS__)
+
+#endif // DBC_CLASS_INVARIANT_H
@@ -27,16 +27,23 @@
 #ifndef DBC_H
 #define DBC_H
 
-#include <cassert>
-#include <chrono>
-#include <functional>
-#include <iostream>
-#include <sstream>
-#include <stdexcept>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
 #include <string_view>
-#include <thread>
+#include <type_traits>
+#include <utility>
 
-#define DBC_API
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+#include "dbc/dbc_macros.hpp"
 
 // PURPOSE: Provide build-specific, runtime-configurable, Design By Contract style, assertion
 // macros, with powerful debugging capabilities. Macros: DBC_REQUIRE, DBC_ENSURE, DBC_INVARIANT
@@ -82,10 +89,165 @@ DBC_API constexpr auto to_string_view(contract type) noexcept
     }
 }
 
+/**
+ * @brief The return addresses of the call stack of a contract violation, innermost first.
+ * Captured only if enabled with dbc::set_stack_traces, and not symbolized until formatted.
+ *
+ */
+DBC_API struct stack_trace
+{
+    static constexpr std::size_t capacity = 32;
+
+    const void* frames[capacity];
+    std::size_t size;
+
+    auto operator==(const stack_trace&) const noexcept -> bool = default;
+    auto operator!=(const stack_trace&) const noexcept -> bool = default;
+};
+
+/**
+ * @brief Operator << overload for a dbc::stack_trace. Symbolizes each frame with
+ * dbc::symbolize. Outputs nothing for an empty stack trace.
+ *
+ * Example output:
+ *
+ * \verbatim
+ * Stack trace:
+ *   #0 0x55d4c2a1b2f3 parse(std::string_view)+0x43 (/usr/bin/app+0x1b2f3)
+ *   #1 0x55d4c2a1b512 main+0x22 (/usr/bin/app+0x1b512)
+ * \endverbatim
+ *
+ */
+DBC_API DBC_INLINE auto operator<<(std::ostream& os, const stack_trace& stack) -> std::ostream&;
+
+/**
+ * @brief A pointer to the stack trace of a contract violation, allocated only once captured, so
+ * that violation contexts stay small. Copies copy the trace. Never null: dereferences to an empty
+ * stack trace if none was captured.
+ *
+ */
+DBC_API class stack_trace_ptr
+{
+public:
+    constexpr stack_trace_ptr() noexcept = default;
+    explicit stack_trace_ptr(const stack_trace& stack) : m_stack{new stack_trace{stack}} {}
+
+    stack_trace_ptr(const stack_trace_ptr& other)
+        : m_stack{other.m_stack ? new stack_trace{*other.m_stack} : nullptr}
+    {}
+
+    stack_trace_ptr(stack_trace_ptr&& other) noexcept
+        : m_stack{std::exchange(other.m_stack, nullptr)}
+    {}
+
+    auto operator=(stack_trace_ptr other) noexcept -> stack_trace_ptr&
+    {
+        std::swap(m_stack, other.m_stack);
+        return *this;
+    }
+
+    ~stack_trace_ptr() { delete m_stack; }
+
+    auto operator*() const noexcept -> const stack_trace& { return m_stack ? *m_stack : empty; }
+    auto operator->() const noexcept -> const stack_trace* { return &**this; }
+
+    friend auto operator==(const stack_trace_ptr& lhs, const stack_trace_ptr& rhs) noexcept
+        -> bool
+    {
+        return *lhs == *rhs;
+    }
+
+private:
+    static constexpr stack_trace empty{};
+
+    stack_trace* m_stack{nullptr};
+};
+
+/**
+ * @brief The developer friendly message of a contract violation.
+ * Refers to a string literal or a std::string_view, or owns a bounded, inline, copy of a formatted
+ * message or a std::string. Owned copies are silently truncated to the capacity (128 characters),
+ * to keep the violation contexts allocation free, so long texts are better passed as views.
+ *
+ */
+DBC_API class violation_message
+{
+public:
+    static constexpr std::size_t capacity = 128;
+
+    constexpr violation_message() noexcept = default;
+    constexpr violation_message(const char* text) noexcept : m_view{text} {}
+    constexpr violation_message(std::string_view text) noexcept : m_view{text} {}
+
+    // Copied, as it is usually a temporary, thus truncated to the capacity.
+    violation_message(const std::string& text) noexcept { assign(text); }
+
+    /**
+     * @brief Returns a violation message that owns a (truncated) copy of a text.
+     *
+     * @param text the text to copy
+     *
+     * @return a violation message that owns a copy of the text
+     */
+    static auto copy(std::string_view text) noexcept -> violation_message
+    {
+        violation_message message;
+        message.assign(text);
+        return message;
+    }
+
+    auto view() const noexcept -> std::string_view
+    {
+        return m_owned ? std::string_view{m_data, m_size} : m_view;
+    }
+
+    auto data() const noexcept -> const char* { return view().data(); }
+    auto size() const noexcept -> std::size_t { return view().size(); }
+    auto empty() const noexcept -> bool { return view().empty(); }
+
+    operator std::string_view() const noexcept { return view(); }
+
+    friend auto operator==(const violation_message& lhs, const violation_message& rhs) noexcept
+        -> bool
+    {
+        return lhs.view() == rhs.view();
+    }
+
+    friend auto operator==(const violation_message& lhs, std::string_view rhs) noexcept -> bool
+    {
+        return lhs.view() == rhs;
+    }
+
+    friend auto operator==(const violation_message& lhs, const char* rhs) noexcept -> bool
+    {
+        return lhs.view() == rhs;
+    }
+
+    friend auto operator<<(std::ostream& os, const violation_message& message) -> std::ostream&
+    {
+        return os << message.view();
+    }
+
+private:
+    void assign(std::string_view text) noexcept
+    {
+        m_size = text.size() < capacity ? text.size() : capacity;
+        std::memcpy(m_data, text.data(), m_size);
+        m_data[m_size] = '\0';
+        m_owned = true;
+    }
+
+    std::string_view m_view;
+    bool m_owned{false};
+    std::size_t m_size{0};
+    char m_data[capacity + 1]{};
+};
+
 /**
  * @brief An aggregate containing the context of a contract violation.
  * Provides useful debug info concerning the contract type, the reported failed condition, the
- * function, file, line, thread, timestamp and an optional, developer friendly, error message.
+ * function, file, line, thread, timestamp, an optional, developer friendly, error message and an
+ * optional stack trace.
  *
  */
 DBC_API struct violation_context
@@ -98,7 +260,8 @@ DBC_API struct violation_context
     int32_t line;
     std::size_t thread_id; // hashed to a unique size_t
     int64_t timestamp;
-    std::string_view message;
+    violation_message message;
+    stack_trace_ptr stack{}; // empty, unless enabled with dbc::set_stack_traces
 
     auto operator==(const violation_context&) const noexcept -> bool = default;
     auto operator!=(const violation_context&) const noexcept -> bool = default;
@@ -120,47 +283,233 @@ DBC_API struct violation_context
  * \endverbatim
  *
  */
-DBC_API inline auto operator<<(std::ostream& os, const violation_context& context) -> std::ostream&
+DBC_API DBC_INLINE auto operator<<(std::ostream& os, const violation_context& context)
+    -> std::ostream&;
+
+/**
+ * @brief The static site of a contract, as referred to by a dbc::violation.
+ *
+ */
+DBC_API struct violation_site
 {
-    return os << "Design By Contract VIOLATION:\n"
-              << to_string_view(context.type) << ":\n  " << context.condition
-              << "\nwith expansion:\n  " << context.decomposition
-              << "\nFunction: " << context.function << ", file: " << context.file
-              << ", line: " << context.line << "\nThread id: " << context.thread_id
-              << ", timestamp(ms): " << context.timestamp << '\n'
-              << context.message << '\n';
-}
+    contract type;
+    std::string_view condition;
+    std::string_view function;
+    std::string_view file;
+    int32_t line;
+    std::string_view message;
+};
+
+/**
+ * @brief A compact, pointer sized, contract violation id, returned from error-return contracts.
+ * A default constructed dbc::violation denotes no violation, thus it can be used as an error code
+ * for functions that do not return a value.
+ *
+ */
+DBC_API class violation
+{
+public:
+    constexpr violation() noexcept = default;
+    constexpr explicit violation(const violation_site* site) noexcept : m_site{site} {}
+
+    /**
+     * @brief Checks whether this instance denotes a contract violation.
+     *
+     * @return true if this instance denotes a contract violation, false otherwise
+     */
+    constexpr explicit operator bool() const noexcept { return m_site != nullptr; }
+
+    /**
+     * @brief Returns the site of the violated contract, or nullptr if there is no violation.
+     *
+     * @return the site of the violated contract, or nullptr if there is no violation
+     */
+    constexpr auto site() const noexcept -> const violation_site* { return m_site; }
+
+    /**
+     * @brief Expands this violation to a violation context, on the calling thread.
+     * The decomposition of the condition is not available.
+     *
+     * @note Must denote a contract violation.
+     *
+     * @return a violation context
+     */
+    DBC_INLINE auto context() const -> violation_context;
+
+    auto operator==(const violation&) const noexcept -> bool = default;
+    auto operator!=(const violation&) const noexcept -> bool = default;
+
+private:
+    const violation_site* m_site{nullptr};
+};
+
+/**
+ * @brief Operator << overload for a dbc::violation.
+ *
+ * Example output:
+ *
+ * \verbatim
+ * Precondition: n > 0, function: parse, file: path_to_buzz/buzz.cpp, line: 100
+ * \endverbatim
+ *
+ */
+DBC_API DBC_INLINE auto operator<<(std::ostream& os, const violation& v) -> std::ostream&;
 
 namespace details
 {
     // Returns the current thread id, hashed.
     /// @private
-    inline auto thread_id() noexcept
+    DBC_INLINE auto thread_id() noexcept -> std::size_t;
+
+    // Returns the current timestamp in ms.
+    /// @private
+    DBC_INLINE auto timestamp() -> int64_t;
+
+#if defined(DBC_COMPILED_LIB)
+    // Produces a violation context, with a stack trace if enabled. Cold, thus never inlined, as
+    // the stack trace starts at its caller. Declared here only if compiled into the library, as
+    // GCC warns on a separate declaration of an inline function that is never inlined.
+    /// @private
+    DBC_COLD auto make_context(contract type, std::string_view condition,
+                               const std::string& decomposition, std::string_view function,
+                               std::string_view file, int32_t line,
+                               const violation_message& message) -> violation_context;
+
+    // Produces a violation context, from the site of a violated contract.
+    /// @private
+    DBC_COLD auto make_context(const violation_site& site) -> violation_context;
+#endif
+
+    // A fixed capacity, allocation free, character buffer. Silently truncates on overflow.
+    /// @private
+    template <std::size_t Capacity>
+    class fixed_buffer
     {
-        using namespace std;
+    public:
+        auto data() const noexcept -> const char* { return m_data; }
+        auto size() const noexcept -> std::size_t { return m_size; }
 
-        return hash<thread::id>()(this_thread::get_id());
-    }
+        auto append(std::string_view str) noexcept -> fixed_buffer&
+        {
+            const auto n = str.size() < Capacity - m_size ? str.size() : Capacity - m_size;
+            std::memcpy(m_data + m_size, str.data(), n);
+            m_size += n;
+            return *this;
+        }
 
-    // Returns the current timestamp in ms.
+        template <std::integral Integer>
+        auto append(Integer value) noexcept -> fixed_buffer&
+        {
+            char digits[24]; // enough for any 64 bit integer, plus sign
+            auto* last = digits + sizeof(digits);
+            auto* first = last;
+
+            // Negate per digit, as -value overflows for the min value.
+            auto negative = false;
+            if constexpr (std::is_signed_v<Integer>) negative = value < 0;
+
+            do
+            {
+                const auto digit = static_cast<int>(value % 10);
+                *--first = static_cast<char>('0' + (negative ? -digit : digit));
+                value /= 10;
+            } while (value != 0);
+
+            if (negative) *--first = '-';
+
+            return append(std::string_view{first, static_cast<std::size_t>(last - first)});
+        }
+
+        auto append_hex(std::uintptr_t value) noexcept -> fixed_buffer&
+        {
+            char digits[2 + 2 * sizeof(value)];
+            auto* last = digits + sizeof(digits);
+            auto* first = last;
+
+            do
+            {
+                *--first = "0123456789abcdef"[value & 0xf];
+                value >>= 4;
+            } while (value != 0);
+
+            *--first = 'x';
+            *--first = '0';
+
+            return append(std::string_view{first, static_cast<std::size_t>(last - first)});
+        }
+
+    private:
+        char m_data[Capacity];
+        std::size_t m_size{0};
+    };
+
+    // Formats a violation context as its operator << overload does, without allocating.
     /// @private
-    inline auto timestamp()
+    template <std::size_t Capacity>
+    inline void format(fixed_buffer<Capacity>& buf, const violation_context& context) noexcept
     {
-        using namespace std::chrono;
+        buf.append("Design By Contract VIOLATION:\n")
+            .append(to_string_view(context.type))
+            .append(":\n  ")
+            .append(context.condition)
+            .append("\nwith expansion:\n  ")
+            .append(std::string_view{context.decomposition})
+            .append("\nFunction: ")
+            .append(context.function)
+            .append(", file: ")
+            .append(context.file)
+            .append(", line: ")
+            .append(context.line)
+            .append("\nThread id: ")
+            .append(context.thread_id)
+            .append(", timestamp(ms): ")
+            .append(context.timestamp)
+            .append("\n")
+            .append(context.message)
+            .append("\n");
+
+        // Unsymbolized, as symbolization is not async-signal-safe.
+        if (context.stack->size != 0) buf.append("Stack trace:\n");
+        for (std::size_t i = 0; i < context.stack->size; ++i)
+        {
+            buf.append("  #")
+                .append(i)
+                .append(" ")
+                .append_hex(reinterpret_cast<std::uintptr_t>(context.stack->frames[i]))
+                .append("\n");
+        }
 
-        const auto until_now = system_clock::now().time_since_epoch();
-        return duration_cast<milliseconds>(until_now).count();
+        buf.append("\n");
     }
 
-    // Produces a violation context.
+    // Writes a buffer to the standard error with a single system call.
     /// @private
-    inline auto make_context(contract type, std::string_view condition,
-                             const std::string& decomposition, std::string_view function,
-                             std::string_view file, int32_t line, std::string_view message)
+    DBC_INLINE void write_stderr(const char* data, std::size_t size) noexcept;
+
+    // The early return value of a violated error-return contract.
+    // Converts to any type implicitly constructible from a dbc::violation, or to any
+    // std::expected<T, E> with E implicitly constructible from a dbc::violation.
+    /// @private
+    struct violation_return
     {
-        return violation_context{type, condition,   decomposition, function, file,
-                                 line, thread_id(), timestamp(),   message};
-    }
+        violation value;
+
+        template <typename R>
+        requires std::is_convertible_v<violation, R>
+        constexpr operator R() const noexcept(std::is_nothrow_convertible_v<violation, R>)
+        {
+            return value;
+        }
+
+#if defined(__cpp_lib_expected)
+        template <typename T, typename E>
+        requires std::is_convertible_v<violation, E>
+        constexpr operator std::expected<T, E>() const
+        {
+            return std::unexpected<E>{value};
+        }
+#endif
+    };
 
     //
     // Credits to: https://theheisenbugblog.wordpress.com/2014/09/06/c-expression-decomposition/
@@ -168,6 +517,26 @@ namespace details
 
     struct lhs_decomposer; // fwd declaration
 
+    // An output string stream, owned through an opaque pointer, so that the decomposers do not
+    // need <sstream>.
+    /// @private
+    class decomposition_stream
+    {
+    public:
+        DBC_INLINE decomposition_stream();
+        DBC_INLINE ~decomposition_stream();
+
+        decomposition_stream(const decomposition_stream&) = delete;
+        auto operator=(const decomposition_stream&) -> decomposition_stream& = delete;
+
+        auto stream() noexcept -> std::ostream& { return *m_stream; }
+
+        DBC_INLINE auto str() const -> std::string;
+
+    private:
+        std::ostream* m_stream;
+    };
+
     // Decomposes a boolean expression, given its left hand side operand
     // Makes use of the operator overloads to deduce the right hand operand and the operation.
     class rhs_decomposer
@@ -176,48 +545,48 @@ namespace details
         template <typename T>
         explicit rhs_decomposer(const T& lhs)
         {
-            ss << lhs;
+            ss.stream() << lhs;
         }
 
         template <typename T>
         auto operator==(const T& rhs) -> const auto&
         {
-            ss << " == " << rhs;
+            ss.stream() << " == " << rhs;
             return *this;
         }
 
         template <typename T>
         auto operator!=(const T& rhs) -> const auto&
         {
-            ss << " != " << rhs;
+            ss.stream() << " != " << rhs;
             return *this;
         }
 
         template <typename T>
         auto operator<(const T& rhs) -> const auto&
         {
-            ss << " < " << rhs;
+            ss.stream() << " < " << rhs;
             return *this;
         }
 
         template <typename T>
         auto operator>(const T& rhs) -> const auto&
         {
-            ss << " > " << rhs;
+            ss.stream() << " > " << rhs;
             return *this;
         }
 
         template <typename T>
         auto operator<=(const T& rhs) -> const auto&
         {
-            ss << " <= " << rhs;
+            ss.stream() << " <= " << rhs;
             return *this;
         }
 
         template <typename T>
         auto operator>=(const T& rhs) -> const auto&
         {
-            ss << " >= " << rhs;
+            ss.stream() << " >= " << rhs;
             return *this;
         }
 
@@ -226,7 +595,7 @@ namespace details
         auto decomposition() const -> auto { return ss.str(); }
 
     private:
-        std::stringstream ss;
+        decomposition_stream ss;
     };
 
     // Hepler struct, forwards a left hand side opperand to a right hand side decomposer
@@ -239,239 +608,197 @@ namespace details
         }
     };
 
-} // namespace details
+    // Appends a message argument. Booleans, characters, integers, enumerations, strings and
+    // pointers are appended in place, anything else through its operator << overload.
+    /// @private
+    template <std::size_t Capacity, typename T>
+    void append_argument(fixed_buffer<Capacity>& buf, const T& arg)
+    {
+        using namespace std::string_view_literals;
+
+        if constexpr (std::is_same_v<T, bool>)
+            buf.append(arg ? "true"sv : "false"sv);
+        else if constexpr (std::is_same_v<T, char>)
+            buf.append(std::string_view{&arg, 1});
+        else if constexpr (std::is_integral_v<T>)
+            buf.append(arg);
+        else if constexpr (std::is_enum_v<T>)
+            buf.append(static_cast<std::underlying_type_t<T>>(arg));
+        else if constexpr (std::is_null_pointer_v<T>)
+            buf.append("nullptr"sv);
+        else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, const char*>)
+            buf.append(arg ? std::string_view{arg} : "nullptr"sv);
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            buf.append(std::string_view{arg});
+        else if constexpr (std::is_pointer_v<T>)
+            buf.append_hex(reinterpret_cast<std::uintptr_t>(arg));
+        else
+        {
+            decomposition_stream ss;
+            ss.stream() << arg;
+            buf.append(std::string_view{ss.str()});
+        }
+    }
 
-/** @} */
+    // Returns a single message argument as is.
+    /// @private
+    template <typename Message>
+    constexpr auto make_message(const Message& message) noexcept -> const Message&
+    {
+        return message;
+    }
 
-} // namespace dbc
+    // Counts the "{}" placeholders of a message format, past the "{{" and "}}" escaped braces.
+    /// @private
+    constexpr auto count_placeholders(std::string_view format) noexcept -> std::size_t
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i + 1 < format.size(); ++i)
+        {
+            if (format[i] == '{' && format[i + 1] == '}')
+                ++count, ++i;
+            else if ((format[i] == '{' || format[i] == '}') && format[i + 1] == format[i])
+                ++i;
+        }
 
-// Utility macro to obtain an std::string decomposition of a boolean expression
-#define DBC_DECOMPOSE(expr)                                                                        \
-    ([]() -> dbc::details::lhs_decomposer { return {}; }()->*expr).decomposition()
+        return count;
+    }
 
-// Utility macro to obtain __FUNCTION__, __FILE__ and __LINE__
-#define DBC_GET_CONTEXT(type, condition, message)                                                  \
-    dbc::details::make_context(type, #condition, DBC_DECOMPOSE(condition), __FUNCTION__, __FILE__, \
-                               __LINE__, message)
+    // Not constexpr, to name the error of a mismatched message format at compile time.
+    /// @private
+    inline void message_placeholders_do_not_match_the_arguments() {}
 
-// ---------------------------------------------------------------------------------------- //
+    // A message format, whose placeholders are checked against the arguments at compile time, as
+    // with std::format_string.
+    /// @private
+    template <typename... Args>
+    class format_string
+    {
+    public:
+        template <typename Text>
+        requires std::convertible_to<const Text&, std::string_view>
+        consteval format_string(const Text& text) : m_text{text}
+        {
+            if (count_placeholders(m_text) != sizeof...(Args))
+                message_placeholders_do_not_match_the_arguments();
+        }
 
-// ------------------------- Error Handling ----------------------------------------------- //
+        constexpr auto get() const noexcept -> std::string_view { return m_text; }
 
-namespace dbc
-{
+    private:
+        std::string_view m_text;
+    };
 
-/** @defgroup error_handling Error Handling
- *  @{
- */
+    // Formats a message, replacing each "{}" with the next argument. "{{" and "}}" are escaped
+    // braces. Called only on a violation, into a bounded buffer that the message owns.
+    /// @private
+    template <typename... Args>
+    requires(sizeof...(Args) > 0)
+    auto make_message(format_string<std::type_identity_t<Args>...> message, const Args&... args)
+        -> violation_message
+    {
+        const auto format = message.get();
+        fixed_buffer<violation_message::capacity> buf;
 
-/**
- * @brief A violation context, error handler, function alias.
- *
- */
-DBC_API using violation_handler = std::function<void(const violation_context&)>;
+        const auto append_nth = [&](std::size_t n) {
+            std::size_t i = 0;
+            ((i++ == n ? append_argument(buf, args) : void()), ...);
+        };
 
-/**
- * @brief A generic contract violation exception.
- * Encapsulates preconditions, postconditions and invariants violations.
- *
- */
-DBC_API class contract_violation : public std::logic_error
-{
-public:
-    explicit contract_violation(violation_context context)
-        : logic_error{context.message.data()}, m_context{std::move(context)}
-    {}
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < format.size(); ++i)
+        {
+            const auto c = format[i];
+            const auto has_next = i + 1 < format.size();
+
+            if (c == '{' && has_next && format[i + 1] == '}')
+                append_nth(next++), ++i;
+            else if ((c == '{' || c == '}') && has_next && format[i + 1] == c)
+                buf.append(std::string_view{&c, 1}), ++i;
+            else
+                buf.append(std::string_view{&c, 1});
+        }
 
-    /**
-     * @brief Returns a read access to the violation context that was handled from this instance.
-     *
-     * @return a read access to the violation context that was handled from this instance
-     */
-    auto context() const noexcept -> const auto& { return m_context; };
+        return violation_message::copy(std::string_view{buf.data(), buf.size()});
+    }
 
-private:
-    violation_context m_context;
-};
+} // namespace details
 
-/**
- * @brief Handles a dbc::violation_context by aborting. Logs the violation to std::cerr.
- *
- * @note This is the default error handler.
- *
- * @param context the violation context to handle
- */
-DBC_API [[noreturn]] inline void abort_handler(const violation_context& context)
+/** @} */
+
+} // namespace dbc
+
+// ---------------------------------------------------------------------------------------- //
+
+// ------------------------- Error Handling ----------------------------------------------- //
+
+namespace dbc
 {
-    std::cerr << context << '\n';
-    std::abort();
-}
 
-/**
- * @brief Handles a dbc::violation_context by throwing a dbc::contract_violation error.
- *
- * @param context the violation context to handle
+/** @defgroup error_handling Error Handling
+ *  @{
  */
-DBC_API [[noreturn]] inline void throw_handler(const violation_context& context)
-{
-    throw contract_violation{context};
-}
 
 namespace details
 {
-    // Returns the violation handler function.
+    // Forwards a violation to the thread sink, if any, or to the set violation handler.
     /// @private
-    inline auto handler() noexcept -> auto&
-    {
-        static violation_handler handler = abort_handler;
-        return handler;
-    }
+    DBC_INLINE void dispatch(const violation_context& context);
 
-    // Forwards the reported violation to the set violation handler.
+    // Reports a violation. Inline in both modes, so that the violation tracepoint follows the
+    // DBC_TRACEPOINTS definition of the calling code.
     /// @private
-    inline void handle(const violation_context& context) { handler()(context); }
+    inline void handle(const violation_context& context)
+    {
+        DBC_TRACE4(violation, context.condition.data(), context.file.data(),
+                   static_cast<int>(context.type), context.line);
+
+        dispatch(context);
+    }
 
 } // namespace details
 
 /**
- * @brief Sets the global violation error handler function.
- * Any reported contract violations will be handled from this function.
+ * @brief Enables, or disables, the capture of a stack trace into each violation context. Disabled
+ * on default.
+ *
+ * The capture walks the unwind tables into a fixed array of return addresses, costing a few
+ * microseconds, without allocating, nor symbolizing, on the failing thread. Symbolization is
+ * deferred to the formatting of the context, or can be done offline, with the module offsets, e.g.
+ * with addr2line.
  *
- * @param handler the violation handler function
+ * @param enabled true to capture stack traces, false otherwise
  */
-DBC_API inline void set_violation_handler(const violation_handler& handler) noexcept
-{
-    details::handler() = handler;
-}
-
-/** @} */
-
-} // namespace dbc
-
-// ---------------------------------------------------------------------------------------- //
-
-// ------------------------- Error Checking ----------------------------------------------- //
+DBC_API DBC_INLINE void set_stack_traces(bool enabled) noexcept;
 
 /**
- * @defgroup error_checking Error Checking
- * @ {
+ * @brief Symbolizes a return address, as "address symbol+offset (module+offset)", where available.
+ * Symbols of executables require linking with -rdynamic. The module offset of a return address
+ * points past its call instruction.
  *
- * DBC comes with certain compilation options to configure its assertions accross the different
- * contracts. On default, the assertions have no runtime effect.
+ * @param address the return address
  *
- * @par DBC_ASSERT_LEVEL_NONE
- *  All assertions have no runtime effect. Precondtion, postcondition and invariants checks are
- *  turned to noops.
- *
- * @par DBC_ASSERT_LEVEL_PRECONDITIONS
- *  Only precondition checks are monitored. Hence, the DBC_REQUIRE checker is the only checker that
- * is not turned to a noop.
- *
- * @par DBC_ASSERT_LEVEL_POSTCONDITIONS
- *  Both preconditions and postconditions, validated with the DBC_REQUIRE and DBC_ENSURE macros, are
- *  monitored. Invariant checks are turned to noops.
- *
- * @par DBC_ASSERT_LEVEL_INVARIANTS
- *  All assertions are monitored.
- *
- * Additionally each DBC assertion is overloaded, in order to provide a developer friendly error
- * message.
+ * @return the symbolized return address
  */
+DBC_API DBC_INLINE auto symbolize(const void* address) -> std::string;
 
-#define DBC_ASSERT_IMPL(type, expr, msg)                                                           \
-    if (!(expr)) dbc::details::handle(DBC_GET_CONTEXT(type, expr, msg));
-
-#if defined(DBC_ASSERT_LEVEL_NONE) // assertions have no run-time effect.
-
-#if defined(DBC_ASSERT_LEVEL_PRECONDITIONS) || defined(DBC_ASSERT_LEVEL_POSTCONDITIONS) ||         \
-    defined(DBC_ASSERT_LEVEL_INVARIANTS)
-#error "Multiple DBC assert levels defined"
-#endif
-
-#define DBC_REQUIRE1(expr) void(0)
-#define DBC_REQUIRE2(expr, msg) void(0)
-
-#define DBC_ENSURE1(expr) void(0)
-#define DBC_ENSURE2(expr, msg) void(0)
+/** @} */
 
-#define DBC_INVARIANT1(expr) void(0)
-#define DBC_INVARIANT2(expr, msg) void(0)
+} // namespace dbc
 
-#elif defined(DBC_ASSERT_LEVEL_PRECONDITIONS) // monitor preconditions only
+// ---------------------------------------------------------------------------------------- //
 
-#if defined(DBC_ASSERT_LEVEL_NONE) || defined(DBC_ASSERT_LEVEL_POSTCONDITIONS) ||                  \
-    defined(DBC_ASSERT_LEVEL_INVARIANTS)
-#error "Multiple DBC assert levels defined"
+// The handlers, and the definitions, unless compiled into the library. See dbc/handlers.hpp.
+#if !defined(DBC_COMPILED_LIB)
+#include "dbc/handlers.hpp"
 #endif
 
-#define DBC_REQUIRE1(expr) DBC_ASSERT_IMPL(dbc::contract::precondition, expr, "")
-#define DBC_REQUIRE2(expr, msg) DBC_ASSERT_IMPL(dbc::contract::precondition, expr, msg)
-
-#define DBC_ENSURE1(expr) void(0)
-#define DBC_ENSURE2(expr, msg) void(0)
-
-#define DBC_INVARIANT1(expr) void(0)
-#define DBC_INVARIANT2(expr, msg) void(0)
-
-#elif defined(DBC_ASSERT_LEVEL_POSTCONDITIONS) // monitor preconditions and postconditions
-
-#if defined(DBC_ASSERT_LEVEL_PRECONDITIONS) || defined(DBC_ASSERT_LEVEL_NONE) ||                   \
-    defined(DBC_ASSERT_LEVEL_INVARIANTS)
-#error "Multiple DBC assert levels defined"
+#if defined(DBC_SITE_TOGGLES)
+#include "dbc/site_toggles.hpp"
 #endif
 
-#define DBC_REQUIRE1(expr) DBC_ASSERT_IMPL(dbc::contract::precondition, expr, "")
-#define DBC_REQUIRE2(expr, msg) DBC_ASSERT_IMPL(dbc::contract::precondition, expr, msg)
-
-#define DBC_ENSURE1(expr) DBC_ASSERT_IMPL(dbc::contract::postcondition, expr, "")
-#define DBC_ENSURE2(expr, msg) DBC_ASSERT_IMPL(dbc::contract::postcondition, expr, msg)
-
-#define DBC_INVARIANT1(expr) void(0)
-#define DBC_INVARIANT2(expr, msg) void(0)
-
-#elif defined(DBC_ASSERT_LEVEL_INVARIANTS) // monitor preconditions, postconditions and invariants
-
-#if defined(DBC_ASSERT_LEVEL_PRECONDITIONS) || defined(DBC_ASSERT_LEVEL_POSTCONDITIONS) ||         \
-    defined(DBC_ASSERT_LEVEL_NONE)
-#error "Multiple DBC assert levels defined"
-#endif
-
-#define DBC_REQUIRE1(expr) DBC_ASSERT_IMPL(dbc::contract::precondition, expr, "")
-#define DBC_REQUIRE2(expr, msg) DBC_ASSERT_IMPL(dbc::contract::precondition, expr, msg)
-
-#define DBC_ENSURE1(expr) DBC_ASSERT_IMPL(dbc::contract::postcondition, expr, "")
-#define DBC_ENSURE2(expr, msg) DBC_ASSERT_IMPL(dbc::contract::postcondition, expr, msg)
-
-#define DBC_INVARIANT1(expr) DBC_ASSERT_IMPL(dbc::contract::invariant, expr, "")
-#define DBC_INVARIANT2(expr, msg) DBC_ASSERT_IMPL(dbc::contract::invariant, expr, msg)
-
-#else
-
-#define DBC_REQUIRE1(expr)
-#define DBC_REQUIRE2(expr, msg)
-
-#define DBC_ENSURE1(expr)
-#define DBC_ENSURE2(expr, msg)
-
-#define DBC_INVARIANT1(expr)
-#define DBC_INVARIANT2(expr, msg)
-
+#if defined(DBC_SHARED_STATS)
+#include "dbc/shared_stats.hpp"
 #endif
 
-#define DBC_EXPAND(x) x                       // MSVC workaround
-#define DBC_GET_MACRO(_1, _2, NAME, ...) NAME // Macro overloading trick
-
-#define DBC_REQUIRE(...)                                                                           \
-    DBC_EXPAND(DBC_GET_MACRO(__VA_ARGS__, DBC_REQUIRE2, DBC_REQUIRE1)(__VA_ARGS__))
-
-#define DBC_ENSURE(...)                                                                            \
-    DBC_EXPAND(DBC_GET_MACRO(__VA_ARGS__, DBC_ENSURE2, DBC_ENSURE1)(__VA_ARGS__))
-
-#define DBC_INVARIANT(...)                                                                         \
-    DBC_EXPAND(DBC_GET_MACRO(__VA_ARGS__, DBC_INVARIANT2, DBC_INVARIANT1)(__VA_ARGS__))
-
-/** @} */
-
-// ---------------------------------------------------------------------------------------- //
-
 #endif // DBC_H
\ No newline at end of file
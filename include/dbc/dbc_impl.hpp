@@ -0,0 +1,305 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_IMPL_H
+#define DBC_IMPL_H
+
+#include "dbc/handlers.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if __has_include(<unwind.h>)
+#include <unwind.h>
+#endif
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#endif
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+// PURPOSE: Define the cold machinery of dbc.hpp (formatting, handler storage, context creation).
+// Included by dbc/handlers.hpp, unless DBC_COMPILED_LIB is defined, in which case it is compiled
+// once, into the dbc library.
+
+namespace dbc
+{
+
+DBC_INLINE auto operator<<(std::ostream& os, const violation_context& context) -> std::ostream&
+{
+    return os << "Design By Contract VIOLATION:\n"
+              << to_string_view(context.type) << ":\n  " << context.condition
+              << "\nwith expansion:\n  " << context.decomposition
+              << "\nFunction: " << context.function << ", file: " << context.file
+              << ", line: " << context.line << "\nThread id: " << context.thread_id
+              << ", timestamp(ms): " << context.timestamp << '\n'
+              << context.message << '\n'
+              << *context.stack;
+}
+
+DBC_INLINE auto operator<<(std::ostream& os, const stack_trace& stack) -> std::ostream&
+{
+    if (stack.size != 0) os << "Stack trace:\n";
+
+    for (std::size_t i = 0; i < stack.size; ++i)
+        os << "  #" << i << ' ' << symbolize(stack.frames[i]) << '\n';
+
+    return os;
+}
+
+DBC_INLINE auto operator<<(std::ostream& os, const violation& v) -> std::ostream&
+{
+    if (!v) return os << "No violation";
+
+    const auto& site = *v.site();
+    return os << to_string_view(site.type) << ": " << site.condition
+              << ", function: " << site.function << ", file: " << site.file
+              << ", line: " << site.line;
+}
+
+namespace details
+{
+    DBC_INLINE auto thread_id() noexcept -> std::size_t
+    {
+        using namespace std;
+
+        return hash<thread::id>()(this_thread::get_id());
+    }
+
+    DBC_INLINE auto timestamp() -> int64_t
+    {
+        using namespace std::chrono;
+
+        const auto until_now = system_clock::now().time_since_epoch();
+        return duration_cast<milliseconds>(until_now).count();
+    }
+
+    // Whether to capture stack traces into the violation contexts.
+    /// @private
+    inline auto stack_traces() noexcept -> std::atomic<bool>&
+    {
+        static constinit std::atomic<bool> enabled{false};
+        return enabled;
+    }
+
+    // Captures the return addresses of the calling thread's stack, starting at the given caller's
+    // frame, if found. Does not allocate, nor symbolize.
+    /// @private
+    DBC_COLD DBC_INLINE void capture_stack(stack_trace& stack, const void* caller) noexcept
+    {
+        stack.size = 0;
+
+#if __has_include(<unwind.h>)
+        _Unwind_Backtrace(
+            [](_Unwind_Context* context, void* arg) {
+                auto& s = *static_cast<stack_trace*>(arg);
+
+                const auto ip = _Unwind_GetIP(context);
+                if (ip == 0 || s.size == stack_trace::capacity) return _URC_END_OF_STACK;
+
+                s.frames[s.size++] = reinterpret_cast<const void*>(ip);
+                return _URC_NO_REASON;
+            },
+            &stack);
+
+        // Trims our own frames, however many were inlined or split.
+        for (std::size_t i = 0; i < stack.size; ++i)
+        {
+            if (stack.frames[i] != caller) continue;
+
+            for (std::size_t j = i; j < stack.size; ++j)
+                stack.frames[j - i] = stack.frames[j];
+            stack.size -= i;
+            break;
+        }
+#endif
+    }
+
+    // Cold, thus never inlined, as the stack trace starts at the caller.
+    DBC_COLD DBC_INLINE auto make_context(contract type, std::string_view condition,
+                                          const std::string& decomposition,
+                                          std::string_view function, std::string_view file,
+                                          int32_t line, const violation_message& message)
+        -> violation_context
+    {
+        violation_context context{type, condition,   decomposition, function, file,
+                                  line, thread_id(), timestamp(),   message};
+
+        if (stack_traces().load(std::memory_order_relaxed)) [[unlikely]]
+        {
+            stack_trace stack;
+            capture_stack(stack, DBC_RETURN_ADDRESS());
+            context.stack = stack_trace_ptr{stack};
+        }
+
+        return context;
+    }
+
+    DBC_COLD DBC_INLINE auto make_context(const violation_site& site) -> violation_context
+    {
+        violation_context context{site.type,   site.condition, {},          site.function,
+                                  site.file,   site.line,      thread_id(), timestamp(),
+                                  site.message};
+
+        if (stack_traces().load(std::memory_order_relaxed)) [[unlikely]]
+        {
+            stack_trace stack;
+            capture_stack(stack, DBC_RETURN_ADDRESS());
+            context.stack = stack_trace_ptr{stack};
+        }
+
+        return context;
+    }
+
+    DBC_INLINE void write_stderr(const char* data, std::size_t size) noexcept
+    {
+#if defined(_WIN32)
+        [[maybe_unused]] const auto written = ::_write(2, data, static_cast<unsigned>(size));
+#else
+        [[maybe_unused]] const auto written = ::write(STDERR_FILENO, data, size);
+#endif
+    }
+
+    DBC_INLINE decomposition_stream::decomposition_stream() : m_stream{new std::ostringstream} {}
+
+    DBC_INLINE decomposition_stream::~decomposition_stream() { delete m_stream; }
+
+    DBC_INLINE auto decomposition_stream::str() const -> std::string
+    {
+        return static_cast<const std::ostringstream*>(m_stream)->str();
+    }
+
+} // namespace details
+
+DBC_INLINE auto violation::context() const -> violation_context
+{
+    return details::make_context(*m_site);
+}
+
+DBC_INLINE void abort_handler(const violation_context& context)
+{
+    std::cerr << context << '\n';
+    std::abort();
+}
+
+DBC_INLINE void safe_abort_handler(const violation_context& context) noexcept
+{
+    details::fixed_buffer<4096> buf;
+    details::format(buf, context);
+    details::write_stderr(buf.data(), buf.size());
+    std::abort();
+}
+
+DBC_INLINE void throw_handler(const violation_context& context)
+{
+    throw contract_violation{context};
+}
+
+namespace details
+{
+    DBC_INLINE auto handler() noexcept -> violation_handler&
+    {
+        static violation_handler handler = abort_handler;
+        return handler;
+    }
+
+    DBC_INLINE auto thread_sink() noexcept -> violation_sink&
+    {
+        static thread_local constinit violation_sink sink{nullptr, nullptr};
+        return sink;
+    }
+
+    DBC_INLINE void dispatch(const violation_context& context)
+    {
+        if (const auto& sink = thread_sink(); sink.record)
+            sink.record(sink.self, context);
+        else
+            handler()(context);
+    }
+
+} // namespace details
+
+DBC_INLINE void set_violation_handler(const violation_handler& handler) noexcept
+{
+    details::handler() = handler;
+}
+
+DBC_INLINE void set_stack_traces(bool enabled) noexcept
+{
+    details::stack_traces().store(enabled, std::memory_order_relaxed);
+}
+
+DBC_INLINE auto symbolize(const void* address) -> std::string
+{
+    std::ostringstream ss;
+    ss << address;
+
+#if __has_include(<dlfcn.h>)
+    Dl_info info{};
+    if (::dladdr(address, &info) == 0) return ss.str();
+
+    const auto offset = [address](const void* base) {
+        return reinterpret_cast<std::uintptr_t>(address) - reinterpret_cast<std::uintptr_t>(base);
+    };
+
+    if (info.dli_sname)
+    {
+        std::string_view name{info.dli_sname};
+
+#if __has_include(<cxxabi.h>)
+        auto status = 0;
+        const std::unique_ptr<char, decltype(&std::free)> demangled{
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free};
+        if (status == 0) name = demangled.get();
+#endif
+
+        ss << ' ' << name << "+0x" << std::hex << offset(info.dli_saddr) << std::dec;
+    }
+
+    if (info.dli_fname)
+        ss << " (" << info.dli_fname << "+0x" << std::hex << offset(info.dli_fbase) << std::dec
+           << ')';
+#endif
+
+    return ss.str();
+}
+
+} // namespace dbc
+
+#endif // DBC_IMPL_H
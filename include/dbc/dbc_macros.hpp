@@ -0,0 +1,460 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_MACROS_H
+#define DBC_MACROS_H
+
+// PURPOSE: Provide the dbc macros, without the declarations, for the importers of the dbc module,
+// as modules do not export macros. Included by dbc.hpp. Macros: DBC_REQUIRE, DBC_ENSURE,
+// DBC_INVARIANT
+
+#define DBC_API
+
+// Compiled library mode. The cold machinery (formatting, handler storage, context creation) is
+// defined once, in the dbc library, instead of inline in every translation unit.
+#if defined(DBC_COMPILED_LIB)
+#define DBC_INLINE
+#else
+#define DBC_INLINE inline
+#endif
+
+// Static (USDT) tracepoints, a single nop when no tracer is attached.
+#if defined(DBC_TRACEPOINTS)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define DBC_TRACE4(name, a1, a2, a3, a4) DTRACE_PROBE4(dbc, name, a1, a2, a3, a4)
+#define DBC_TRACE5(name, a1, a2, a3, a4, a5) DTRACE_PROBE5(dbc, name, a1, a2, a3, a4, a5)
+#else
+#error "DBC_TRACEPOINTS requires <sys/sdt.h>, e.g. from the systemtap-sdt-dev package"
+#endif
+#else
+#define DBC_TRACE4(name, a1, a2, a3, a4) void(0)
+#define DBC_TRACE5(name, a1, a2, a3, a4, a5) void(0)
+#endif
+
+// Marks a function as unlikely to be called, to keep it out of the hot path.
+#if defined(__GNUC__) || defined(__clang__)
+#define DBC_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define DBC_COLD __declspec(noinline)
+#else
+#define DBC_COLD
+#endif
+
+// The address that the current function returns to, to trim the stack traces past its caller.
+#if defined(__GNUC__) || defined(__clang__)
+#define DBC_RETURN_ADDRESS() __builtin_return_address(0)
+#else
+#define DBC_RETURN_ADDRESS() nullptr
+#endif
+
+// Utility macro to obtain an std::string decomposition of a boolean expression
+#define DBC_DECOMPOSE(expr)                                                                        \
+    ([]() -> dbc::details::lhs_decomposer { return {}; }()->*expr).decomposition()
+
+// Utility macro to obtain a violation message, formatted from its arguments, if any
+#define DBC_MESSAGE(...) dbc::details::make_message(__VA_ARGS__)
+
+// Utility macro to obtain __FUNCTION__, __FILE__ and __LINE__
+#define DBC_GET_CONTEXT(type, condition, expr, message)                                            \
+    dbc::details::make_context(type, condition, DBC_DECOMPOSE(expr), __FUNCTION__, __FILE__,       \
+                               __LINE__, message)
+
+// ------------------------- Error Checking ----------------------------------------------- //
+
+/**
+ * @defgroup error_checking Error Checking
+ * @ {
+ *
+ * DBC comes with certain compilation options to configure its assertions accross the different
+ * contracts. On default, the assertions have no runtime effect.
+ *
+ * @par DBC_ASSERT_LEVEL_NONE
+ *  All assertions have no runtime effect. Precondtion, postcondition and invariants checks are
+ *  turned to noops.
+ *
+ * @par DBC_ASSERT_LEVEL_PRECONDITIONS
+ *  Only precondition checks are monitored. Hence, the DBC_REQUIRE checker is the only checker that
+ * is not turned to a noop.
+ *
+ * @par DBC_ASSERT_LEVEL_POSTCONDITIONS
+ *  Both preconditions and postconditions, validated with the DBC_REQUIRE and DBC_ENSURE macros, are
+ *  monitored. Invariant checks are turned to noops.
+ *
+ * @par DBC_ASSERT_LEVEL_INVARIANTS
+ *  All assertions are monitored.
+ *
+ * Orthogonally to the assert level, each assertion comes in three cost tiers:
+ *
+ * @par Default (DBC_REQUIRE, DBC_ENSURE, DBC_INVARIANT)
+ *  Cheap checks, monitored according to the assert level.
+ *
+ * @par Audit (DBC_REQUIRE_AUDIT, DBC_ENSURE_AUDIT, DBC_INVARIANT_AUDIT)
+ *  Expensive checks, e.g. whole-structure invariants. Monitored according to the assert level, only
+ *  if DBC_ASSERT_AUDIT is defined too. Thus, release builds can ship with cheap checks on, while
+ *  test builds keep the expensive ones.
+ *
+ * @par Axiom (DBC_REQUIRE_AXIOM, DBC_ENSURE_AXIOM, DBC_INVARIANT_AXIOM)
+ *  Assume-only checks, that are never evaluated at runtime, e.g. because they cannot be evaluated
+ *  at all. The condition must still be a well formed boolean expression.
+ *
+ * @par DBC_ASSUME_UNCHECKED
+ *  Opt-in. Contracts that are not monitored are turned to optimizer hints, instead of noops, e.g.
+ *  DBC_REQUIRE(n % 8 == 0) lets the compiler drop the remainder loop of a vectorized kernel. A
+ *  false assumption is undefined behavior. The conditions are never evaluated. Contracts are only
+ *  assumed where the compiler offers a non-evaluating assumption ([[assume]], __builtin_assume,
+ *  __assume), elsewhere (e.g. GCC < 13) they are noops.
+ *
+ * @par Error-return (DBC_REQUIRE_OR_RETURN, DBC_ENSURE_OR_RETURN, DBC_INVARIANT_OR_RETURN)
+ *  Monitored according to the assert level, but instead of calling the violation handler, return
+ *  early from the enclosing function with a compact dbc::violation id. The enclosing function must
+ *  return a type that is implicitly constructible from a dbc::violation (e.g. dbc::violation
+ *  itself), or an std::expected<T, E> with such an E. Messages must be constant expressions.
+ *  When not monitored, they are noops, and are never assumed (see DBC_ASSUME_UNCHECKED), since
+ *  they guard against conditions that are expected to fail.
+ *
+ * @par DBC_TRACEPOINTS
+ *  Opt-in. Each DBC_REQUIRE, DBC_ENSURE and DBC_INVARIANT assertion (including the audit ones)
+ *  fires the dbc:evaluate_begin and dbc:evaluate_end static tracepoints around its evaluation, and
+ *  each handled violation fires dbc:violation. The probes carry the site id (the address of a
+ *  per-site copy of the condition string), the file, the contract type and the line, while
+ *  dbc:evaluate_end carries whether the condition held, too. Memory assertions fire them too.
+ *  Attachable with perf or bpftrace, e.g.
+ *  bpftrace -e 'usdt:./app:dbc:violation { printf("%s:%d\n", str(arg1), arg3); }'.
+ *  Requires <sys/sdt.h>. Not available in constexpr functions, as the per-site copy of the
+ *  condition is a static variable.
+ *
+ * @par DBC_SHARED_STATS
+ *  Opt-in, POSIX only. Each DBC_REQUIRE, DBC_ENSURE and DBC_INVARIANT assertion (including the
+ *  audit ones) counts its evaluations and violations into a shared memory region, opened with
+ *  dbc::open_shared_stats, which is shared by all the processes that open the same file, or fork
+ *  after opening it. Read live with the dbc_stats tool. Not available in constexpr functions, as
+ *  the per-site counters handle is a static variable. See dbc/shared_stats.hpp.
+ *
+ * @par DBC_SITE_TOGGLES
+ *  Opt-in. Each DBC_REQUIRE, DBC_ENSURE and DBC_INVARIANT assertion (including the audit and
+ *  error-return ones) can be enabled or disabled at runtime, by glob patterns over its file,
+ *  function and condition, initialized from the DBC_SITES and DBC_SITES_FILE environment
+ *  variables. A disabled assertion costs one relaxed load of a per-site byte. Not available in
+ *  constexpr functions, as the per-site byte is a static variable. See dbc/site_toggles.hpp.
+ *
+ * Additionally each DBC assertion is overloaded, in order to provide a developer friendly error
+ * message. The message can be a format string, followed by up to 8 arguments, each replacing a
+ * "{}", e.g. DBC_REQUIRE(found, "tag {} missing", tag). The arguments are captured by reference
+ * and formatted only on a violation, into a bounded buffer owned by the dbc::violation_context.
+ * As with std::format, the "{}" must match the arguments, which is checked at compile time. The
+ * error-return assertions accept a static message only.
+ */
+
+// Prefixes the condition of an assertion with its site enable flag, if DBC_SITE_TOGGLES. The _AT
+// form takes the function name, for the sites that are checked in a lambda.
+#if defined(DBC_SITE_TOGGLES)
+#define DBC_SITE_ENABLED_AT(function, condition)                                                   \
+    static constinit dbc::details::site_toggle dbc_toggle{__FILE__, function, condition};          \
+    dbc_toggle.enabled() &&
+#else
+#define DBC_SITE_ENABLED_AT(function, condition)
+#endif
+
+#define DBC_SITE_ENABLED(condition) DBC_SITE_ENABLED_AT(__FUNCTION__, condition)
+
+// Counts the evaluation of an assertion into the shared stats region, if DBC_SHARED_STATS.
+#if defined(DBC_SHARED_STATS)
+#define DBC_COUNT_EVALUATION(type, condition, held)                                                \
+    static constinit dbc::details::shared_stat_site dbc_stat{type, __FILE__, __LINE__, condition}; \
+    dbc_stat.count(held)
+#else
+#define DBC_COUNT_EVALUATION(type, condition, held) void(0)
+#endif
+
+// Declares the condition string of an assertion site. With DBC_TRACEPOINTS, a per-site static
+// copy, whose address is the site id of the probes, which keeps the site out of constexpr
+// functions, as do the statics of DBC_SITE_ENABLED and DBC_COUNT_EVALUATION.
+#if defined(DBC_TRACEPOINTS)
+#define DBC_SITE_CONDITION(name, condition) static constexpr char name[] = condition
+#else
+#define DBC_SITE_CONDITION(name, condition) constexpr const char* name = condition
+#endif
+
+// The common path of the assertions, with the site toggle, tracepoints and shared stats of the
+// site condition. Runs the fail statement if the held expression is false.
+#if defined(DBC_TRACEPOINTS) || defined(DBC_SHARED_STATS)
+#define DBC_CHECK_AT_IMPL(type, function, condition, held, fail)                                   \
+    if (DBC_SITE_ENABLED_AT(function, condition) true)                                             \
+    {                                                                                              \
+        DBC_TRACE4(evaluate_begin, condition, __FILE__, static_cast<int>(type), __LINE__);         \
+        const bool dbc_held = static_cast<bool>(held);                                             \
+        DBC_TRACE5(evaluate_end, condition, __FILE__, static_cast<int>(type), __LINE__,            \
+                   static_cast<int>(dbc_held));                                                    \
+        DBC_COUNT_EVALUATION(type, condition, dbc_held);                                           \
+        if (!dbc_held) fail;                                                                       \
+    }
+#else
+#define DBC_CHECK_AT_IMPL(type, function, condition, held, fail)                                   \
+    if (DBC_SITE_ENABLED_AT(function, condition) !(held)) fail;
+#endif
+
+#define DBC_CHECK_IMPL(type, condition, held, fail)                                                \
+    DBC_CHECK_AT_IMPL(type, __FUNCTION__, condition, held, fail)
+
+#define DBC_ASSERT_IMPL(type, expr, msg)                                                           \
+    do                                                                                             \
+    {                                                                                              \
+        DBC_SITE_CONDITION(dbc_condition, #expr);                                                  \
+        DBC_CHECK_IMPL(type, dbc_condition, expr,                                                  \
+                       dbc::details::handle(DBC_GET_CONTEXT(type, dbc_condition, expr, msg)))      \
+    } while (false)
+
+#define DBC_ASSERT_OR_RETURN_IMPL(type, expr, msg)                                                 \
+    do                                                                                             \
+    {                                                                                              \
+        if (DBC_SITE_ENABLED(#expr) !(expr)) [[unlikely]]                                          \
+        {                                                                                          \
+            static constexpr dbc::violation_site dbc_site{type,     #expr,    __FUNCTION__,        \
+                                                          __FILE__, __LINE__, msg};                \
+            return dbc::details::violation_return{dbc::violation{&dbc_site}};                      \
+        }                                                                                          \
+    } while (false)
+
+// Checks a boolean expression for well-formedness, without evaluating it.
+#define DBC_UNEVALUATED(expr) static_cast<void>(sizeof(!(expr)))
+
+// Hints the optimizer that a boolean expression is true, without evaluating it. Compilers without
+// a non-evaluating assumption (e.g. GCC < 13) only check the expression for well-formedness.
+#if __has_cpp_attribute(assume)
+#define DBC_ASSUME(expr) [[assume(expr)]]
+#elif defined(__clang__)
+#define DBC_ASSUME(expr) __builtin_assume(expr)
+#elif defined(_MSC_VER)
+#define DBC_ASSUME(expr) __assume(expr)
+#else
+#define DBC_ASSUME(expr) DBC_UNEVALUATED(expr)
+#endif
+
+// Expansions of the contracts that are not monitored, per tier.
+#if defined(DBC_ASSUME_UNCHECKED)
+#define DBC_UNCHECKED(expr) DBC_ASSUME(expr)
+#define DBC_UNCHECKED_AUDIT(expr) DBC_ASSUME(expr)
+#define DBC_UNCHECKED_AXIOM(expr) DBC_ASSUME(expr)
+#else
+#define DBC_UNCHECKED(expr) void(0)
+#define DBC_UNCHECKED_AUDIT(expr) void(0)
+#define DBC_UNCHECKED_AXIOM(expr) DBC_UNEVALUATED(expr)
+#endif
+
+#if defined(DBC_ASSERT_LEVEL_NONE) // assertions have no run-time effect.
+
+#if defined(DBC_ASSERT_LEVEL_PRECONDITIONS) || defined(DBC_ASSERT_LEVEL_POSTCONDITIONS) ||         \
+    defined(DBC_ASSERT_LEVEL_INVARIANTS)
+#error "Multiple DBC assert levels defined"
+#endif
+
+#define DBC_PRECONDITIONS_ENABLED 0
+#define DBC_POSTCONDITIONS_ENABLED 0
+#define DBC_INVARIANTS_ENABLED 0
+
+#elif defined(DBC_ASSERT_LEVEL_PRECONDITIONS) // monitor preconditions only
+
+#if defined(DBC_ASSERT_LEVEL_NONE) || defined(DBC_ASSERT_LEVEL_POSTCONDITIONS) ||                  \
+    defined(DBC_ASSERT_LEVEL_INVARIANTS)
+#error "Multiple DBC assert levels defined"
+#endif
+
+#define DBC_PRECONDITIONS_ENABLED 1
+#define DBC_POSTCONDITIONS_ENABLED 0
+#define DBC_INVARIANTS_ENABLED 0
+
+#elif defined(DBC_ASSERT_LEVEL_POSTCONDITIONS) // monitor preconditions and postconditions
+
+#if defined(DBC_ASSERT_LEVEL_PRECONDITIONS) || defined(DBC_ASSERT_LEVEL_NONE) ||                   \
+    defined(DBC_ASSERT_LEVEL_INVARIANTS)
+#error "Multiple DBC assert levels defined"
+#endif
+
+#define DBC_PRECONDITIONS_ENABLED 1
+#define DBC_POSTCONDITIONS_ENABLED 1
+#define DBC_INVARIANTS_ENABLED 0
+
+#elif defined(DBC_ASSERT_LEVEL_INVARIANTS) // monitor preconditions, postconditions and invariants
+
+#if defined(DBC_ASSERT_LEVEL_PRECONDITIONS) || defined(DBC_ASSERT_LEVEL_POSTCONDITIONS) ||         \
+    defined(DBC_ASSERT_LEVEL_NONE)
+#error "Multiple DBC assert levels defined"
+#endif
+
+#define DBC_PRECONDITIONS_ENABLED 1
+#define DBC_POSTCONDITIONS_ENABLED 1
+#define DBC_INVARIANTS_ENABLED 1
+
+#else
+
+#define DBC_PRECONDITIONS_ENABLED 0
+#define DBC_POSTCONDITIONS_ENABLED 0
+#define DBC_INVARIANTS_ENABLED 0
+
+#endif
+
+#if defined(DBC_ASSERT_AUDIT) // monitor the audit tier too
+#define DBC_AUDIT_ENABLED 1
+#else
+#define DBC_AUDIT_ENABLED 0
+#endif
+
+#if DBC_PRECONDITIONS_ENABLED
+#define DBC_REQUIRE1(expr) DBC_ASSERT_IMPL(dbc::contract::precondition, expr, "")
+#define DBC_REQUIRE2(expr, ...)                                                                    \
+    DBC_ASSERT_IMPL(dbc::contract::precondition, expr, DBC_MESSAGE(__VA_ARGS__))
+#else
+#define DBC_REQUIRE1(expr) DBC_UNCHECKED(expr)
+#define DBC_REQUIRE2(expr, ...) DBC_UNCHECKED(expr)
+#endif
+
+#if DBC_POSTCONDITIONS_ENABLED
+#define DBC_ENSURE1(expr) DBC_ASSERT_IMPL(dbc::contract::postcondition, expr, "")
+#define DBC_ENSURE2(expr, ...)                                                                     \
+    DBC_ASSERT_IMPL(dbc::contract::postcondition, expr, DBC_MESSAGE(__VA_ARGS__))
+#else
+#define DBC_ENSURE1(expr) DBC_UNCHECKED(expr)
+#define DBC_ENSURE2(expr, ...) DBC_UNCHECKED(expr)
+#endif
+
+#if DBC_INVARIANTS_ENABLED
+#define DBC_INVARIANT1(expr) DBC_ASSERT_IMPL(dbc::contract::invariant, expr, "")
+#define DBC_INVARIANT2(expr, ...)                                                                  \
+    DBC_ASSERT_IMPL(dbc::contract::invariant, expr, DBC_MESSAGE(__VA_ARGS__))
+#else
+#define DBC_INVARIANT1(expr) DBC_UNCHECKED(expr)
+#define DBC_INVARIANT2(expr, ...) DBC_UNCHECKED(expr)
+#endif
+
+#if DBC_PRECONDITIONS_ENABLED && DBC_AUDIT_ENABLED
+#define DBC_REQUIRE_AUDIT1(expr) DBC_REQUIRE1(expr)
+#define DBC_REQUIRE_AUDIT2(expr, ...) DBC_REQUIRE2(expr, __VA_ARGS__)
+#else
+#define DBC_REQUIRE_AUDIT1(expr) DBC_UNCHECKED_AUDIT(expr)
+#define DBC_REQUIRE_AUDIT2(expr, ...) DBC_UNCHECKED_AUDIT(expr)
+#endif
+
+#if DBC_POSTCONDITIONS_ENABLED && DBC_AUDIT_ENABLED
+#define DBC_ENSURE_AUDIT1(expr) DBC_ENSURE1(expr)
+#define DBC_ENSURE_AUDIT2(expr, ...) DBC_ENSURE2(expr, __VA_ARGS__)
+#else
+#define DBC_ENSURE_AUDIT1(expr) DBC_UNCHECKED_AUDIT(expr)
+#define DBC_ENSURE_AUDIT2(expr, ...) DBC_UNCHECKED_AUDIT(expr)
+#endif
+
+#if DBC_INVARIANTS_ENABLED && DBC_AUDIT_ENABLED
+#define DBC_INVARIANT_AUDIT1(expr) DBC_INVARIANT1(expr)
+#define DBC_INVARIANT_AUDIT2(expr, ...) DBC_INVARIANT2(expr, __VA_ARGS__)
+#else
+#define DBC_INVARIANT_AUDIT1(expr) DBC_UNCHECKED_AUDIT(expr)
+#define DBC_INVARIANT_AUDIT2(expr, ...) DBC_UNCHECKED_AUDIT(expr)
+#endif
+
+#define DBC_REQUIRE_AXIOM1(expr) DBC_UNCHECKED_AXIOM(expr)
+#define DBC_REQUIRE_AXIOM2(expr, ...) DBC_UNCHECKED_AXIOM(expr)
+
+#define DBC_ENSURE_AXIOM1(expr) DBC_UNCHECKED_AXIOM(expr)
+#define DBC_ENSURE_AXIOM2(expr, ...) DBC_UNCHECKED_AXIOM(expr)
+
+#define DBC_INVARIANT_AXIOM1(expr) DBC_UNCHECKED_AXIOM(expr)
+#define DBC_INVARIANT_AXIOM2(expr, ...) DBC_UNCHECKED_AXIOM(expr)
+
+#if DBC_PRECONDITIONS_ENABLED
+#define DBC_REQUIRE_OR_RETURN1(expr)                                                               \
+    DBC_ASSERT_OR_RETURN_IMPL(dbc::contract::precondition, expr, "")
+#define DBC_REQUIRE_OR_RETURN2(expr, msg)                                                          \
+    DBC_ASSERT_OR_RETURN_IMPL(dbc::contract::precondition, expr, msg)
+#else
+#define DBC_REQUIRE_OR_RETURN1(expr) void(0)
+#define DBC_REQUIRE_OR_RETURN2(expr, msg) void(0)
+#endif
+
+#if DBC_POSTCONDITIONS_ENABLED
+#define DBC_ENSURE_OR_RETURN1(expr)                                                                \
+    DBC_ASSERT_OR_RETURN_IMPL(dbc::contract::postcondition, expr, "")
+#define DBC_ENSURE_OR_RETURN2(expr, msg)                                                           \
+    DBC_ASSERT_OR_RETURN_IMPL(dbc::contract::postcondition, expr, msg)
+#else
+#define DBC_ENSURE_OR_RETURN1(expr) void(0)
+#define DBC_ENSURE_OR_RETURN2(expr, msg) void(0)
+#endif
+
+#if DBC_INVARIANTS_ENABLED
+#define DBC_INVARIANT_OR_RETURN1(expr) DBC_ASSERT_OR_RETURN_IMPL(dbc::contract::invariant, expr, "")
+#define DBC_INVARIANT_OR_RETURN2(expr, msg)                                                        \
+    DBC_ASSERT_OR_RETURN_IMPL(dbc::contract::invariant, expr, msg)
+#else
+#define DBC_INVARIANT_OR_RETURN1(expr) void(0)
+#define DBC_INVARIANT_OR_RETURN2(expr, msg) void(0)
+#endif
+
+#define DBC_EXPAND(x) x                       // MSVC workaround
+#define DBC_GET_MACRO(_1, _2, NAME, ...) NAME // Macro overloading trick
+#define DBC_GET_MACRO3(_1, _2, _3, NAME, ...) NAME
+#define DBC_GET_MACRO5(_1, _2, _3, _4, _5, NAME, ...) NAME
+
+// Selects the 1 argument overload, or the message overload, with up to 8 message arguments
+#define DBC_GET_MESSAGE_MACRO(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, NAME, ...) NAME
+#define DBC_SELECT_MESSAGE_MACRO(name, ...)                                                        \
+    DBC_EXPAND(DBC_GET_MESSAGE_MACRO(__VA_ARGS__, name##2, name##2, name##2, name##2, name##2,    \
+                                     name##2, name##2, name##2, name##2, name##1)(__VA_ARGS__))
+
+#define DBC_REQUIRE(...) DBC_SELECT_MESSAGE_MACRO(DBC_REQUIRE, __VA_ARGS__)
+
+#define DBC_ENSURE(...) DBC_SELECT_MESSAGE_MACRO(DBC_ENSURE, __VA_ARGS__)
+
+#define DBC_INVARIANT(...) DBC_SELECT_MESSAGE_MACRO(DBC_INVARIANT, __VA_ARGS__)
+
+#define DBC_REQUIRE_AUDIT(...) DBC_SELECT_MESSAGE_MACRO(DBC_REQUIRE_AUDIT, __VA_ARGS__)
+
+#define DBC_ENSURE_AUDIT(...) DBC_SELECT_MESSAGE_MACRO(DBC_ENSURE_AUDIT, __VA_ARGS__)
+
+#define DBC_INVARIANT_AUDIT(...) DBC_SELECT_MESSAGE_MACRO(DBC_INVARIANT_AUDIT, __VA_ARGS__)
+
+#define DBC_REQUIRE_AXIOM(...) DBC_SELECT_MESSAGE_MACRO(DBC_REQUIRE_AXIOM, __VA_ARGS__)
+
+#define DBC_ENSURE_AXIOM(...) DBC_SELECT_MESSAGE_MACRO(DBC_ENSURE_AXIOM, __VA_ARGS__)
+
+#define DBC_INVARIANT_AXIOM(...) DBC_SELECT_MESSAGE_MACRO(DBC_INVARIANT_AXIOM, __VA_ARGS__)
+
+#define DBC_REQUIRE_OR_RETURN(...)                                                                 \
+    DBC_EXPAND(                                                                                    \
+        DBC_GET_MACRO(__VA_ARGS__, DBC_REQUIRE_OR_RETURN2, DBC_REQUIRE_OR_RETURN1)(__VA_ARGS__))
+
+#define DBC_ENSURE_OR_RETURN(...)                                                                  \
+    DBC_EXPAND(                                                                                    \
+        DBC_GET_MACRO(__VA_ARGS__, DBC_ENSURE_OR_RETURN2, DBC_ENSURE_OR_RETURN1)(__VA_ARGS__))
+
+#define DBC_INVARIANT_OR_RETURN(...)                                                               \
+    DBC_EXPAND(                                                                                    \
+        DBC_GET_MACRO(__VA_ARGS__, DBC_INVARIANT_OR_RETURN2, DBC_INVARIANT_OR_RETURN1)(__VA_ARGS__))
+
+/** @} */
+
+// ---------------------------------------------------------------------------------------- //
+
+#endif // DBC_MACROS_H
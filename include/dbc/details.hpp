@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_DETAILS_H
+#define DBC_DETAILS_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+
+// PURPOSE: Provide the implementation details shared by the dbc headers of fixed layout, shared,
+// mappings, e.g. the flight recorder and the shared stats.
+
+namespace dbc::details
+{
+
+// Copies the head of a string view into a fixed, null terminated, buffer.
+/// @private
+template <std::size_t N>
+inline void copy_head(char (&to)[N], std::string_view from) noexcept
+{
+    const auto n = std::min(from.size(), N - 1);
+    std::memcpy(to, from.data(), n);
+    to[n] = '\0';
+}
+
+// Appends the head of a string view to a fixed, null terminated, buffer.
+/// @private
+template <std::size_t N>
+inline void append_head(char (&to)[N], std::string_view from) noexcept
+{
+    const auto size = static_cast<std::size_t>(std::find(to, to + N - 1, '\0') - to);
+    const auto n = std::min(from.size(), N - 1 - size);
+    std::memcpy(to + size, from.data(), n);
+    to[size + n] = '\0';
+}
+
+// Copies the tail of a string view into a fixed, null terminated, buffer.
+/// @private
+template <std::size_t N>
+inline void copy_tail(char (&to)[N], std::string_view from) noexcept
+{
+    const auto n = std::min(from.size(), N - 1);
+    std::memcpy(to, from.data() + from.size() - n, n);
+    to[n] = '\0';
+}
+
+// Returns the contents of a fixed buffer, up to its null terminator, if any.
+/// @private
+template <std::size_t N>
+inline auto fixed_view(const char (&from)[N]) noexcept -> std::string_view
+{
+    return {from, static_cast<std::size_t>(std::find(from, from + N, '\0') - from)};
+}
+
+// Checks whether a fixed buffer holds the copy_head of a string view.
+/// @private
+template <std::size_t N>
+inline auto equals_head(const char (&buffer)[N], std::string_view from) noexcept -> bool
+{
+    return fixed_view(buffer) == from.substr(0, N - 1);
+}
+
+// Checks whether a fixed buffer holds the copy_tail of a string view.
+/// @private
+template <std::size_t N>
+inline auto equals_tail(const char (&buffer)[N], std::string_view from) noexcept -> bool
+{
+    return fixed_view(buffer) == from.substr(from.size() - std::min(from.size(), N - 1));
+}
+
+// Throws an std::system_error from the current errno value.
+/// @private
+[[noreturn]] inline void throw_errno(const char* what)
+{
+    throw std::system_error{errno, std::generic_category(), what};
+}
+
+} // namespace dbc::details
+
+#endif // DBC_DETAILS_H
@@ -0,0 +1,525 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_FLIGHT_RECORDER_H
+#define DBC_FLIGHT_RECORDER_H
+
+#include "dbc/handlers.hpp"
+#include "dbc/details.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "The dbc flight recorder requires a POSIX platform"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// PURPOSE: Provide a crash-surviving, per-thread, ring buffer of the last contract violations,
+// backed by a shared file mapping (e.g. under /dev/shm) that can be dumped post-mortem.
+
+namespace dbc
+{
+
+/** @defgroup flight_recording Flight Recording
+ *  @{
+ */
+
+/**
+ * @brief A compact, fixed-size, violation record, as stored in a flight recorder mapping.
+ *
+ * String fields are truncated copies of the violation context views. The file keeps its tail, the
+ * other fields keep their head. All strings are null terminated.
+ *
+ */
+DBC_API struct flight_record
+{
+    uint64_t sequence; // 1-based, per thread, 0 marks an empty or partially written record
+    int64_t timestamp;
+    uint64_t thread_id;
+    int32_t line;
+    uint8_t type; // a dbc::contract
+    uint8_t reserved[3];
+    char function[40];
+    char file[72];
+    char condition[80];
+    char message[32];
+};
+
+static_assert(sizeof(flight_record) == 256, "flight records must keep a fixed on-disk layout");
+
+/**
+ * @brief Operator << overload for a dbc::flight_record.
+ *
+ * Example output:
+ *
+ * \verbatim
+ * #3 Invariant: x == 0, function: main, file: buzz.cpp, line: 100, timestamp(ms): 1650122348195
+ * \endverbatim
+ *
+ */
+DBC_API inline auto operator<<(std::ostream& os, const flight_record& record) -> std::ostream&
+{
+    os << '#' << record.sequence << ' ' << to_string_view(static_cast<contract>(record.type))
+       << ": " << record.condition << ", function: " << record.function
+       << ", file: " << record.file << ", line: " << record.line
+       << ", timestamp(ms): " << record.timestamp;
+
+    if (record.message[0] != '\0') os << ", message: " << record.message;
+
+    return os;
+}
+
+namespace details
+{
+    // The flight recorder mapping header. Located at offset 0 of the mapping.
+    /// @private
+    struct flight_header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t threads;
+        uint32_t records;
+        std::atomic<uint64_t> dropped; // records of threads that found no free slot
+        int64_t pid;
+    };
+
+    // A per-thread ring of flight records, owned by a single writer thread.
+    /// @private
+    struct flight_slot
+    {
+        std::atomic<uint64_t> thread_id; // of the owner thread, 0 if free
+        std::atomic<uint64_t> head; // number of records ever written to this slot
+    };
+
+    /// @private
+    inline constexpr char flight_magic[8] = {'D', 'B', 'C', 'F', 'L', 'I', 'G', 'H'};
+
+    /// @private
+    inline constexpr uint32_t flight_version = 2;
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                      std::atomic<uint64_t>::is_always_lock_free,
+                  "the flight recorder mapping requires address-free atomics");
+
+    // Returns the byte size of a single thread slot, records included.
+    /// @private
+    constexpr auto flight_slot_size(std::size_t records) noexcept
+    {
+        return sizeof(flight_slot) + records * sizeof(flight_record);
+    }
+
+    // Returns the byte size of a flight recorder mapping.
+    /// @private
+    constexpr auto flight_mapping_size(std::size_t threads, std::size_t records) noexcept
+    {
+        return sizeof(flight_header) + threads * flight_slot_size(records);
+    }
+
+    // Returns the record array of a thread slot.
+    /// @private
+    inline auto flight_records(flight_slot* slot) noexcept
+    {
+        return reinterpret_cast<flight_record*>(slot + 1);
+    }
+
+    // The ids of the live flight recorders, so that exiting threads release their slots only
+    // into mappings that are still mapped.
+    /// @private
+    struct flight_registry
+    {
+        std::mutex mutex;
+        std::vector<uint64_t> recorders;
+    };
+
+    /// @private
+    inline auto flight_recorders() -> flight_registry&
+    {
+        static flight_registry registry;
+        return registry;
+    }
+
+    // The slots claimed by a thread, per flight recorder. Released on thread exit.
+    /// @private
+    struct flight_thread_slots
+    {
+        struct entry
+        {
+            uint64_t recorder;
+            flight_slot* slot;
+        };
+
+        std::vector<entry> entries;
+
+        flight_thread_slots() = default;
+        flight_thread_slots(const flight_thread_slots&) = delete;
+        auto operator=(const flight_thread_slots&) -> flight_thread_slots& = delete;
+
+        ~flight_thread_slots()
+        {
+            auto& registry = flight_recorders();
+            std::scoped_lock lock{registry.mutex};
+
+            for (const auto& [recorder, slot] : entries)
+                if (std::ranges::find(registry.recorders, recorder) != registry.recorders.end())
+                    slot->thread_id.store(0, std::memory_order_release);
+        }
+    };
+
+    /// @private
+    inline auto thread_flight_slots() noexcept -> flight_thread_slots&
+    {
+        static thread_local flight_thread_slots slots;
+        return slots;
+    }
+
+} // namespace details
+
+/**
+ * @brief A crash-surviving, per-thread, violation flight recorder.
+ *
+ * Maps a file (preferably under /dev/shm) shared, and lays out one fixed-size ring of
+ * dbc::flight_record objects per recording thread. The mapping outlives the process, thus the last
+ * violations leading up to a crash can be inspected post-mortem, e.g. with the dbc_flight_dump
+ * tool.
+ *
+ * Recording a violation takes no locks and issues no system calls: the calling thread claims a
+ * free slot once, with a compare-and-swap, and from then on writes its records with plain stores.
+ * The slot is released when the thread exits, for the next threads to reuse. Threads that find no
+ * free slot have their records dropped and counted.
+ *
+ */
+DBC_API class flight_recorder
+{
+public:
+    static constexpr std::size_t default_threads = 64;
+    static constexpr std::size_t default_records = 32;
+
+    /**
+     * @brief Creates (or truncates) and maps the flight recorder file at the given path.
+     *
+     * @param path the backing file path, e.g. /dev/shm/myapp.dbc
+     * @param threads the max number of recording threads
+     * @param records the number of last records kept per thread
+     *
+     * @throws std::system_error if the file cannot be created or mapped
+     * @throws std::invalid_argument if threads or records is zero
+     */
+    explicit flight_recorder(std::string path, std::size_t threads = default_threads,
+                             std::size_t records = default_records)
+        : m_path{std::move(path)}
+        , m_threads{threads}
+        , m_records{records}
+        , m_size{details::flight_mapping_size(threads, records)}
+    {
+        if (threads == 0 || records == 0)
+            throw std::invalid_argument{"flight recorder needs at least one thread and record"};
+
+        // The header stores 32 bit counts.
+        if (threads > UINT32_MAX || records > UINT32_MAX)
+            throw std::invalid_argument{"flight recorder threads or records out of range"};
+
+        const auto fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd == -1) details::throw_errno("dbc::flight_recorder: open");
+
+        if (::ftruncate(fd, static_cast<off_t>(m_size)) == -1)
+        {
+            ::close(fd);
+            details::throw_errno("dbc::flight_recorder: ftruncate");
+        }
+
+        auto* addr = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) details::throw_errno("dbc::flight_recorder: mmap");
+
+        m_base = static_cast<std::byte*>(addr);
+
+        // ftruncate zero fills, thus the slots and records start out empty.
+        auto* header = ::new (m_base) details::flight_header{};
+        std::memcpy(header->magic, details::flight_magic, sizeof(header->magic));
+        header->version = details::flight_version;
+        header->threads = static_cast<uint32_t>(threads);
+        header->records = static_cast<uint32_t>(records);
+        header->pid = ::getpid();
+
+        for (std::size_t i = 0; i < threads; ++i) ::new (slot(i)) details::flight_slot{};
+
+        auto& registry = details::flight_recorders();
+        std::scoped_lock lock{registry.mutex};
+        registry.recorders.push_back(m_id);
+    }
+
+    flight_recorder(const flight_recorder&) = delete;
+    flight_recorder(flight_recorder&&) = delete;
+
+    auto operator=(const flight_recorder&) -> flight_recorder& = delete;
+    auto operator=(flight_recorder&&) -> flight_recorder& = delete;
+
+    /**
+     * @brief Unmaps the flight recorder. The backing file is kept.
+     *
+     */
+    ~flight_recorder()
+    {
+        {
+            auto& registry = details::flight_recorders();
+            std::scoped_lock lock{registry.mutex};
+            std::erase(registry.recorders, m_id);
+        }
+
+        ::munmap(m_base, m_size);
+    }
+
+    /**
+     * @brief Returns the backing file path.
+     *
+     * @return the backing file path
+     */
+    auto path() const noexcept -> const auto& { return m_path; }
+
+    /**
+     * @brief Returns the number of records that were dropped, due to running out of thread slots.
+     * The slot of a thread is released when the thread exits.
+     *
+     * @return the number of records that were dropped
+     */
+    auto dropped() const noexcept -> uint64_t
+    {
+        return header()->dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records a violation context into the calling thread's ring.
+     *
+     * @param context the violation context to record
+     */
+    void record(const violation_context& context) noexcept
+    {
+        auto* s = thread_slot();
+        if (!s)
+        {
+            header()->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Single writer per slot: relaxed loads of our own head are enough.
+        const auto head = s->head.load(std::memory_order_relaxed);
+        auto& r = details::flight_records(s)[head % m_records];
+
+        // Mark the record as partially written, so that a crash mid-write cannot be mistaken for a
+        // complete record.
+        std::atomic_ref{r.sequence}.store(0, std::memory_order_relaxed);
+        std::atomic_signal_fence(std::memory_order_release);
+
+        r.timestamp = context.timestamp;
+        r.thread_id = context.thread_id;
+        r.line = context.line;
+        r.type = static_cast<uint8_t>(context.type);
+        details::copy_head(r.function, context.function);
+        details::copy_tail(r.file, context.file);
+        details::copy_head(r.condition, context.condition);
+        details::copy_head(r.message, context.message);
+
+        std::atomic_ref{r.sequence}.store(head + 1, std::memory_order_release);
+        s->head.store(head + 1, std::memory_order_release);
+    }
+
+private:
+    auto header() const noexcept -> details::flight_header*
+    {
+        return reinterpret_cast<details::flight_header*>(m_base);
+    }
+
+    auto slot(std::size_t i) const noexcept -> details::flight_slot*
+    {
+        return reinterpret_cast<details::flight_slot*>(m_base + sizeof(details::flight_header) +
+                                                       i * details::flight_slot_size(m_records));
+    }
+
+    // Returns the calling thread's slot, claiming a free one on first use, or nullptr if none is
+    // left, in which case the claim is retried on the next record.
+    auto thread_slot() noexcept -> details::flight_slot*
+    {
+        auto& entries = details::thread_flight_slots().entries;
+
+        for (const auto& [recorder, s] : entries)
+            if (recorder == m_id) return s;
+
+        // 0 marks a free slot.
+        const auto id = details::thread_id() == 0 ? uint64_t{1} : details::thread_id();
+
+        for (std::size_t i = 0; i < m_threads; ++i)
+        {
+            auto* s = slot(i);
+            auto expected = uint64_t{0};
+
+            if (s->thread_id.load(std::memory_order_relaxed) != 0 ||
+                !s->thread_id.compare_exchange_strong(expected, id, std::memory_order_acquire))
+                continue;
+
+            try
+            {
+                entries.push_back({m_id, s});
+            } catch (...)
+            {
+                s->thread_id.store(0, std::memory_order_release);
+                return nullptr;
+            }
+
+            return s;
+        }
+
+        return nullptr;
+    }
+
+    std::string m_path;
+    std::size_t m_threads;
+    std::size_t m_records;
+    std::size_t m_size;
+    std::byte* m_base{nullptr};
+    uint64_t m_id{next_id()}; // unlike the address, never reused by a later recorder
+
+    static auto next_id() noexcept -> uint64_t
+    {
+        static std::atomic<uint64_t> id{0};
+        return ++id;
+    }
+};
+
+/**
+ * @brief Reads back the complete records of a flight recorder file.
+ *
+ * Can be used post-mortem, or live, on a file that is still being recorded to. Partially written
+ * records are skipped.
+ *
+ * @param path the flight recorder file path
+ *
+ * @return the recorded violations, grouped by thread, oldest first
+ *
+ * @throws std::system_error if the file cannot be read
+ * @throws std::runtime_error if the file is not a flight recorder file
+ */
+DBC_API inline auto load_flight_records(const std::string& path) -> std::vector<flight_record>
+{
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) details::throw_errno("dbc::load_flight_records: open");
+
+    struct stat st{};
+    if (::fstat(fd, &st) == -1)
+    {
+        ::close(fd);
+        details::throw_errno("dbc::load_flight_records: fstat");
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size < sizeof(details::flight_header))
+    {
+        ::close(fd);
+        throw std::runtime_error{"dbc::load_flight_records: not a flight recorder file"};
+    }
+
+    auto* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) details::throw_errno("dbc::load_flight_records: mmap");
+
+    const auto* base = static_cast<const std::byte*>(addr);
+    const auto* header = reinterpret_cast<const details::flight_header*>(base);
+
+    // Divides, rather than multiplies, the counts, so that corrupt counts cannot overflow.
+    const auto valid =
+        std::memcmp(header->magic, details::flight_magic, sizeof(header->magic)) == 0 &&
+        header->version == details::flight_version && header->records != 0 &&
+        header->threads <= (size - sizeof(details::flight_header)) /
+                               details::flight_slot_size(header->records);
+    if (!valid)
+    {
+        ::munmap(addr, size);
+        throw std::runtime_error{"dbc::load_flight_records: not a flight recorder file"};
+    }
+
+    std::vector<flight_record> result;
+    for (std::size_t i = 0; i < header->threads; ++i)
+    {
+        const auto* s = reinterpret_cast<const details::flight_slot*>(
+            base + sizeof(details::flight_header) + i * details::flight_slot_size(header->records));
+        const auto* first = reinterpret_cast<const flight_record*>(s + 1);
+        const auto begin = result.size();
+
+        std::copy_if(first, first + header->records, std::back_inserter(result),
+                     [](const auto& r) { return r.sequence != 0; });
+
+        // The file may be corrupt, or written by a crashing process.
+        for (auto j = begin; j < result.size(); ++j)
+        {
+            auto& r = result[j];
+            r.function[sizeof(r.function) - 1] = '\0';
+            r.file[sizeof(r.file) - 1] = '\0';
+            r.condition[sizeof(r.condition) - 1] = '\0';
+            r.message[sizeof(r.message) - 1] = '\0';
+        }
+
+        std::sort(std::begin(result) + static_cast<std::ptrdiff_t>(begin), std::end(result),
+                  [](const auto& l, const auto& r) { return l.sequence < r.sequence; });
+    }
+
+    ::munmap(addr, size);
+    return result;
+}
+
+/**
+ * @brief Returns a violation handler that records each violation and then forwards it.
+ *
+ * @param recorder the flight recorder, must outlive the returned handler
+ * @param next the violation handler to forward to, e.g. dbc::abort_handler
+ *
+ * @return a violation handler that records each violation and then forwards it
+ */
+DBC_API inline auto make_recording_handler(flight_recorder& recorder, violation_handler next)
+    -> violation_handler
+{
+    return [&recorder, next = std::move(next)](const violation_context& context) {
+        recorder.record(context);
+        if (next) next(context);
+    };
+}
+
+/** @} */
+
+} // namespace dbc
+
+#endif // DBC_FLIGHT_RECORDER_H
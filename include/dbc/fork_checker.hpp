@@ -0,0 +1,409 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_FORK_CHECKER_H
+#define DBC_FORK_CHECKER_H
+
+#include "dbc/handlers.hpp"
+#include "dbc/details.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// PURPOSE: Provide off-process checking of expensive invariants, in forked copy-on-write children
+// that see a consistent snapshot of the parent's memory, while the parent carries on.
+
+namespace dbc
+{
+
+/** @defgroup fork_checking Fork Checking
+ *  @{
+ */
+
+namespace details
+{
+    // The outcome of a check, written by a checker child to its pipe.
+    /// @private
+    struct fork_check_report
+    {
+        uint8_t held;
+        char message[255];
+    };
+
+    static_assert(sizeof(fork_check_report) <= PIPE_BUF, "reports must be written atomically");
+
+    // Waits for a child, retrying if interrupted by a signal.
+    /// @private
+    inline auto wait_child(pid_t pid, int options) noexcept -> pid_t
+    {
+        pid_t result;
+        do
+            result = ::waitpid(pid, nullptr, options);
+        while (result == -1 && errno == EINTR);
+        return result;
+    }
+
+    // Checks whether a pipe has data, or its write end is closed, without blocking.
+    /// @private
+    inline auto is_readable(int fd) noexcept -> bool
+    {
+        pollfd pfd{fd, POLLIN, 0};
+        return ::poll(&pfd, 1, 0) == 1;
+    }
+
+} // namespace details
+
+/**
+ * @brief Checks expensive invariants in forked children, against a copy-on-write snapshot of the
+ * process memory, so that the calling thread pays only for the fork.
+ *
+ * Each check runs in a child process, with DBC assertions throwing, and reports its outcome back
+ * through a pipe. Outcomes are collected by poll, wait, the next check, or the destructor, and the
+ * failed ones are reported to the set violation handler, as invariant violations, at the site
+ * where the check was started.
+ *
+ * Only the forking thread exists in a child, thus checks must not acquire locks that other threads
+ * may have held at the time of the fork, and must not depend on other threads. At most
+ * max_children checks run at once; further checks are skipped. Checks still running after the
+ * timeout are killed, and reported as violations, as are checks whose children were reaped
+ * elsewhere (e.g. with SIGCHLD ignored). Not async-signal-safe. Linux only.
+ *
+ */
+DBC_API class fork_checker
+{
+public:
+    /**
+     * @brief Constructs a fork checker.
+     *
+     * @param max_children the max number of checker children running at once
+     * @param timeout the time after which a running check is killed
+     */
+    explicit fork_checker(std::size_t max_children = 1,
+                          std::chrono::milliseconds timeout = std::chrono::minutes{1}) noexcept
+        : m_max_children{max_children}, m_timeout{timeout}
+    {}
+
+    fork_checker(const fork_checker&) = delete;
+    fork_checker(fork_checker&&) = delete;
+
+    auto operator=(const fork_checker&) -> fork_checker& = delete;
+    auto operator=(fork_checker&&) -> fork_checker& = delete;
+
+    /**
+     * @brief Waits for the running checks, and reports their violations. Exceptions thrown from the
+     * violation handler are swallowed.
+     *
+     */
+    ~fork_checker()
+    {
+        try
+        {
+            wait();
+        } catch (...)
+        {}
+    }
+
+    /**
+     * @brief Starts a check in a forked child, unless max_children checks are already running.
+     *
+     * @param check a callback, returning a bool, true if the invariants hold, or void, checking
+     * them with DBC_INVARIANT assertions
+     * @param description the description of the check, reported as the violated condition
+     * @param where the call site, reported as the violation site
+     *
+     * @return true if the check was started, false if it was skipped, or the fork failed
+     */
+    template <std::invocable Check>
+    auto check(Check check, std::string_view description = "snapshot check",
+               std::source_location where = std::source_location::current()) -> bool
+    {
+        poll();
+
+        std::unique_lock lock{m_mutex};
+
+        if (m_children.size() >= m_max_children)
+        {
+            ++m_skipped;
+            return false;
+        }
+
+        // Nothing may throw past the fork, or the child would never be reaped.
+        m_children.reserve(m_children.size() + 1);
+        child started{0, -1, std::string{description}, where, {}};
+
+        int fds[2];
+        if (::pipe2(fds, O_CLOEXEC) == -1)
+        {
+            ++m_skipped;
+            return false;
+        }
+
+        const auto pid = ::fork();
+        if (pid == 0)
+        {
+            ::close(fds[0]);
+            run_child(check, fds[1]); // never returns
+        }
+
+        ::close(fds[1]);
+
+        if (pid == -1)
+        {
+            ::close(fds[0]);
+            ++m_skipped;
+            return false;
+        }
+
+        started.pid = pid;
+        started.fd = fds[0];
+        started.deadline = std::chrono::steady_clock::now() + m_timeout;
+        m_children.push_back(std::move(started)); // reserved, thus does not throw
+        return true;
+    }
+
+    /**
+     * @brief Collects the finished checks, without blocking, and reports their violations.
+     *
+     * @return the number of collected checks
+     */
+    auto poll() -> std::size_t { return collect(); }
+
+    /**
+     * @brief Waits for all the running checks, up to their timeout, and reports their violations.
+     *
+     */
+    void wait()
+    {
+        do
+            collect();
+        while (wait_any());
+    }
+
+    /**
+     * @brief Returns the number of running checks.
+     *
+     * @return the number of running checks
+     */
+    auto running() const -> std::size_t
+    {
+        std::scoped_lock lock{m_mutex};
+        return m_children.size();
+    }
+
+    /**
+     * @brief Returns the number of checks skipped, due to the max children limit or a failed fork.
+     *
+     * @return the number of skipped checks
+     */
+    auto skipped() const -> std::uint64_t
+    {
+        std::scoped_lock lock{m_mutex};
+        return m_skipped;
+    }
+
+private:
+    struct child
+    {
+        pid_t pid;
+        int fd; // read end of the report pipe
+        std::string description;
+        std::source_location where;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    struct outcome
+    {
+        child from;
+        std::string message;
+    };
+
+    template <typename Check>
+    [[noreturn]] static void run_child(Check& check, int fd) noexcept
+    {
+        details::fork_check_report report{0, {}};
+
+        try
+        {
+            details::thread_sink() = {}; // e.g. a redirection of the forking thread
+            set_violation_handler(throw_handler);
+
+            if constexpr (std::is_void_v<std::invoke_result_t<Check&>>)
+                report.held = (check(), 1);
+            else
+                report.held = static_cast<bool>(check()) ? 1 : 0;
+
+            if (!report.held) details::copy_head(report.message, "Snapshot check failed");
+        } catch (const contract_violation& e)
+        {
+            // As much of the violation as fits, without allocating.
+            const auto& context = e.context();
+            details::copy_head(report.message, context.condition);
+
+            if (!context.decomposition.empty())
+            {
+                details::append_head(report.message, ", with expansion: ");
+                details::append_head(report.message, context.decomposition);
+            }
+
+            if (!context.message.view().empty())
+            {
+                details::append_head(report.message, ", ");
+                details::append_head(report.message, context.message.view());
+            }
+        } catch (const std::exception& e)
+        {
+            details::copy_head(report.message, e.what());
+        } catch (...)
+        {
+            details::copy_head(report.message, "Snapshot check threw");
+        }
+
+        const auto written = ::write(fd, &report, sizeof(report));
+        ::_exit(written == sizeof(report) ? EXIT_SUCCESS : EXIT_FAILURE); // skips atexit handlers
+    }
+
+    // Reaps the finished, or timed out, children, then reports their violations, without holding
+    // the mutex.
+    auto collect() -> std::size_t
+    {
+        std::vector<outcome> violations;
+        std::size_t collected{0};
+
+        {
+            std::scoped_lock lock{m_mutex};
+
+            const auto now = std::chrono::steady_clock::now();
+
+            std::erase_if(m_children, [&](auto& c) {
+                auto reaped = details::wait_child(c.pid, WNOHANG);
+
+                // Wrote its report, or died, thus is reaped without blocking for long.
+                if (reaped == 0 && details::is_readable(c.fd))
+                    reaped = details::wait_child(c.pid, 0);
+
+                if (reaped == 0 && now >= c.deadline)
+                {
+                    ::kill(c.pid, SIGKILL);
+                    details::wait_child(c.pid, 0);
+                    ::close(c.fd);
+                    ++collected;
+                    violations.push_back({std::move(c), "Snapshot check timed out"});
+                    return true;
+                }
+
+                if (reaped == 0) return false; // still running
+
+                // E.g. ECHILD, if reaped elsewhere, in which case the report may still be there.
+                const auto error = reaped == -1 ? errno : 0;
+
+                details::fork_check_report report{};
+                const auto read = details::is_readable(c.fd) ? ::read(c.fd, &report, sizeof(report))
+                                                             : ssize_t{-1};
+                ::close(c.fd);
+                ++collected;
+
+                if (read != sizeof(report) && error != 0)
+                {
+                    const auto reason = std::generic_category().message(error);
+                    violations.push_back({std::move(c), "Snapshot check lost, waitpid: " + reason});
+                }
+                else if (read != sizeof(report))
+                    violations.push_back({std::move(c), "Snapshot check terminated abnormally"});
+                else if (!report.held)
+                    violations.push_back({std::move(c), report.message});
+
+                return true;
+            });
+        }
+
+        for (const auto& [from, message] : violations)
+        {
+            details::handle(details::make_context(
+                contract::invariant, from.description, {}, from.where.function_name(),
+                from.where.file_name(), static_cast<int32_t>(from.where.line()), message));
+        }
+
+        return collected;
+    }
+
+    // Blocks until a running check writes its report, or dies, or the earliest deadline passes.
+    // Returns false if no checks are running.
+    auto wait_any() -> bool
+    {
+        std::vector<pollfd> fds;
+        auto deadline = std::chrono::steady_clock::time_point::max();
+
+        {
+            std::scoped_lock lock{m_mutex};
+            if (m_children.empty()) return false;
+
+            for (const auto& c : m_children)
+            {
+                fds.push_back({c.fd, POLLIN, 0});
+                deadline = std::min(deadline, c.deadline);
+            }
+        }
+
+        const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        ::poll(fds.data(), fds.size(),
+               static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(timeout.count(), 0,
+                                                                           INT_MAX)));
+        return true;
+    }
+
+    std::size_t m_max_children;
+    std::chrono::milliseconds m_timeout;
+    mutable std::mutex m_mutex;
+    std::vector<child> m_children;
+    std::uint64_t m_skipped{0};
+};
+
+/** @} */
+
+} // namespace dbc
+
+#endif // DBC_FORK_CHECKER_H
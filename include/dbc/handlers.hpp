@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef DBC_HANDLERS_H
+#define DBC_HANDLERS_H
+
+#include "dbc/dbc.hpp"
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+// PURPOSE: Provide the violation handlers, and their setter. Included by dbc.hpp, unless
+// DBC_COMPILED_LIB is defined, in which case the code that sets, or catches, the handlers
+// includes it, so that the translation units that only check contracts do not need <functional>.
+
+namespace dbc
+{
+
+/** @addtogroup error_handling
+ *  @{
+ */
+
+/**
+ * @brief A violation context, error handler, function alias.
+ *
+ */
+DBC_API using violation_handler = std::function<void(const violation_context&)>;
+
+/**
+ * @brief A generic contract violation exception.
+ * Encapsulates preconditions, postconditions and invariants violations.
+ *
+ */
+DBC_API class contract_violation : public std::logic_error
+{
+public:
+    explicit contract_violation(violation_context context)
+        : logic_error{context.message.data()}, m_context{std::move(context)}
+    {}
+
+    /**
+     * @brief Returns a read access to the violation context that was handled from this instance.
+     *
+     * @return a read access to the violation context that was handled from this instance
+     */
+    auto context() const noexcept -> const auto& { return m_context; };
+
+private:
+    violation_context m_context;
+};
+
+/**
+ * @brief Handles a dbc::violation_context by aborting. Logs the violation to std::cerr.
+ *
+ * @note This is the default error handler.
+ *
+ * @param context the violation context to handle
+ */
+DBC_API [[noreturn]] DBC_INLINE void abort_handler(const violation_context& context);
+
+/**
+ * @brief Handles a dbc::violation_context by aborting. Logs the violation to the standard error,
+ * in an async-signal-safe manner.
+ *
+ * Unlike dbc::abort_handler, the handler itself does not allocate, nor lock: the violation is
+ * formatted into a stack buffer, which is written with a single write(2) call. Messages longer
+ * than 4KB are truncated. Note that the violation context is built before the handler runs, and
+ * building it allocates (e.g. the decomposition), thus a corrupted heap can still fail before the
+ * handler is reached. A context built in advance can be handled from within a signal handler.
+ *
+ * @param context the violation context to handle
+ */
+DBC_API [[noreturn]] DBC_INLINE void safe_abort_handler(const violation_context& context) noexcept;
+
+/**
+ * @brief Handles a dbc::violation_context by throwing a dbc::contract_violation error.
+ *
+ * @param context the violation context to handle
+ */
+DBC_API [[noreturn]] DBC_INLINE void throw_handler(const violation_context& context);
+
+namespace details
+{
+    // Returns the violation handler function.
+    /// @private
+    DBC_INLINE auto handler() noexcept -> violation_handler&;
+
+    // Redirects the violations of a thread away from the violation handler, e.g. into a
+    // dbc::contract_region.
+    /// @private
+    struct violation_sink
+    {
+        void (*record)(void* self, const violation_context& context);
+        void* self;
+    };
+
+    // Returns the violation sink of the calling thread, empty unless redirected.
+    /// @private
+    DBC_INLINE auto thread_sink() noexcept -> violation_sink&;
+
+} // namespace details
+
+/**
+ * @brief Sets the global violation error handler function.
+ * Any reported contract violations will be handled from this function.
+ *
+ * @param handler the violation handler function
+ */
+DBC_API DBC_INLINE void set_violation_handler(const violation_handler& handler) noexcept;
+
+/** @} */
+
+} // namespace dbc
+
+#if !defined(DBC_COMPILED_LIB)
+#include "dbc/dbc_impl.hpp"
+#endif
+
+#endif // DBC_HANDLERS_H
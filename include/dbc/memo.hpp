@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_MEMO_H
+#define DBC_MEMO_H
+
+#include "dbc/dbc.hpp"
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+
+// PURPOSE: Provide memoized preconditions, for pure predicates that are re-verified on the same
+// inputs over and over, e.g. "is sorted". Macros: DBC_REQUIRE_PURE
+
+/**
+ * @def DBC_MEMO_ENTRIES
+ *  The number of passed inputs remembered per DBC_REQUIRE_PURE site and thread. Defaults to 8.
+ */
+#if !defined(DBC_MEMO_ENTRIES)
+#define DBC_MEMO_ENTRIES 8
+#endif
+
+namespace dbc
+{
+
+/** @defgroup memoization Memoization
+ *  @{
+ */
+
+namespace details
+{
+    // The global memo generation, bumped to invalidate all the memo caches.
+    /// @private
+    inline auto memo_generation() noexcept -> std::atomic<uint64_t>&
+    {
+        static constinit std::atomic<uint64_t> generation{0};
+        return generation;
+    }
+
+    // Mixes two words into a key, never zero, which marks the empty cache entries.
+    /// @private
+    constexpr auto memo_mix(uint64_t lhs, uint64_t rhs) noexcept -> uint64_t
+    {
+        auto x = lhs ^ (rhs + 0x9e3779b97f4a7c15ull + (lhs << 6) + (lhs >> 2));
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x == 0 ? 1 : x;
+    }
+
+    // A user provided memo_version overload, found by ADL.
+    /// @private
+    template <typename T>
+    concept has_memo_version = requires(const T& input) {
+        { memo_version(input) } -> std::convertible_to<uint64_t>;
+    };
+
+    /// @private
+    template <typename T>
+    concept std_hashable = requires(const T& input) {
+        { std::hash<T>{}(input) } -> std::convertible_to<std::size_t>;
+    };
+
+    // Types whose equal values have equal bytes, thus can be hashed by their memory. Not the
+    // pointers, nor the ranges (e.g. std::span), which refer to the values of their pointees.
+    /// @private
+    template <typename T>
+    concept byte_hashable =
+        std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T> &&
+        !std::is_pointer_v<T> && !std::ranges::range<const T>;
+
+    /// @private
+    template <typename T>
+    concept byte_hashable_range =
+        std::ranges::contiguous_range<const T> && std::ranges::sized_range<const T> &&
+        byte_hashable<std::ranges::range_value_t<const T>>;
+
+    /// @private
+    template <typename T>
+    concept hashable_range =
+        std::ranges::input_range<const T> && std_hashable<std::ranges::range_value_t<const T>>;
+
+    // Hashes a block of memory, a word at a time.
+    /// @private
+    inline auto memo_hash_bytes(const void* data, std::size_t size) noexcept -> uint64_t
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        auto hash = memo_mix(size, 0);
+        std::size_t i{0};
+
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+            hash ^= hash >> 32;
+        }
+
+        uint64_t tail{0};
+        std::memcpy(&tail, bytes + i, size - i);
+        return memo_mix(hash, tail);
+    }
+
+    // Returns the key of an input. Inputs with a memo_version are keyed by their address and
+    // version, the rest by a hash of their contents: the elements of ranges, including views,
+    // their memory, if equal values have equal bytes, or their std::hash. Pointers are rejected,
+    // as their pointees may change behind the same key.
+    /// @private
+    template <typename T>
+    auto memo_key(const T& input) noexcept -> uint64_t
+    {
+        static_assert(!std::is_pointer_v<T>,
+                      "DBC_REQUIRE_PURE inputs must not be pointers, pass their pointee or a span");
+
+        if constexpr (has_memo_version<T>)
+        {
+            return memo_mix(reinterpret_cast<uintptr_t>(std::addressof(input)),
+                            static_cast<uint64_t>(memo_version(input)));
+        }
+        else if constexpr (byte_hashable_range<T>)
+        {
+            return memo_hash_bytes(std::ranges::data(input),
+                                   std::ranges::size(input) *
+                                       sizeof(std::ranges::range_value_t<const T>));
+        }
+        else if constexpr (hashable_range<T>)
+        {
+            using hash = std::hash<std::ranges::range_value_t<const T>>;
+
+            uint64_t key{0};
+            for (const auto& element : input) key = memo_mix(key, hash{}(element));
+            return key;
+        }
+        else if constexpr (byte_hashable<T>)
+        {
+            return memo_hash_bytes(std::addressof(input), sizeof(T));
+        }
+        else
+        {
+            static_assert(std_hashable<T>,
+                          "DBC_REQUIRE_PURE inputs must be hashable, ranges of hashable elements, "
+                          "or provide a memo_version overload");
+
+            return memo_mix(std::hash<T>{}(input), 0);
+        }
+    }
+
+    // The last passed input keys of a site, on a thread. Constant initialized, thus thread_local
+    // instances need no guard.
+    /// @private
+    class memo_cache
+    {
+    public:
+        auto contains(uint64_t key) noexcept -> bool
+        {
+            const auto current = memo_generation().load(std::memory_order_acquire);
+            if (m_generation != current) [[unlikely]]
+            {
+                *this = memo_cache{};
+                m_generation = current;
+                return false;
+            }
+
+            for (auto k : m_keys)
+                if (k == key) return true;
+
+            return false;
+        }
+
+        void insert(uint64_t key) noexcept
+        {
+            m_keys[m_next] = key;
+            m_next = (m_next + 1) % DBC_MEMO_ENTRIES;
+        }
+
+    private:
+        uint64_t m_keys[DBC_MEMO_ENTRIES]{};
+        uint64_t m_generation{0};
+        uint32_t m_next{0};
+    };
+
+    // Whether the input passed the predicate recently, on this thread, else evaluates the
+    // predicate, remembering the input if it passes.
+    /// @private
+    template <typename T, typename Predicate>
+    auto memo_passes(memo_cache& cache, const T& input, Predicate predicate) -> bool
+    {
+        const auto key = memo_key(input);
+        if (cache.contains(key)) return true;
+
+        const auto passes = static_cast<bool>(predicate(input));
+        if (passes) cache.insert(key);
+        return passes;
+    }
+
+} // namespace details
+
+/**
+ * @brief Invalidates the memoized results of all the DBC_REQUIRE_PURE sites, on all threads, e.g.
+ * after mutating inputs in place.
+ *
+ * Inputs that are expensive to hash can provide a memo_version(const T&) overload, next to their
+ * type T, returning a version that changes on each mutation, and is never repeated for an
+ * address.
+ *
+ */
+DBC_API inline void invalidate_memos() noexcept
+{
+    details::memo_generation().fetch_add(1, std::memory_order_release);
+}
+
+/** @} */
+
+} // namespace dbc
+
+#if DBC_PRECONDITIONS_ENABLED
+
+// Skips the evaluation of the predicate, if the input passed it recently, on this thread. Checked
+// through the common assertion path.
+#define DBC_REQUIRE_PURE3(predicate, input, msg)                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        static thread_local constinit dbc::details::memo_cache dbc_memo;                           \
+        DBC_SITE_CONDITION(dbc_condition, #predicate "(" #input ")");                              \
+        static constexpr dbc::violation_site dbc_site{                                             \
+            dbc::contract::precondition, dbc_condition, __FUNCTION__, __FILE__, __LINE__, msg};    \
+        const auto& dbc_input = (input);                                                           \
+        DBC_CHECK_IMPL(dbc::contract::precondition, dbc_condition,                                 \
+                       dbc::details::memo_passes(dbc_memo, dbc_input,                              \
+                                                 [&](const auto& x) { return predicate(x); }),     \
+                       dbc::details::handle(dbc::details::make_context(dbc_site)))                 \
+    } while (false)
+
+#else
+
+#define DBC_REQUIRE_PURE3(predicate, input, msg) DBC_UNCHECKED(predicate(input))
+
+#endif
+
+#define DBC_REQUIRE_PURE2(predicate, input) DBC_REQUIRE_PURE3(predicate, input, "")
+
+/**
+ * @def DBC_REQUIRE_PURE(predicate, input [, message])
+ *  A precondition that predicate(input) holds, where the predicate is pure, i.e. its result
+ *  depends only on the input. The keys of the last DBC_MEMO_ENTRIES passing inputs are remembered
+ *  per site and thread, and re-presented inputs are not re-evaluated. Inputs are keyed by a hash
+ *  of their contents, which takes a pass over them, or by their address and memo_version, if they
+ *  provide a memo_version overload. Versions must then never repeat for an address, e.g. drawn
+ *  from a global counter, as destroyed inputs leave their address to new ones. Views (e.g.
+ *  std::span) are keyed by their elements, pointers do not compile, and other types that hold
+ *  pointers are keyed by the pointers, not the pointees. Failing inputs are never remembered.
+ *  Checked through the common assertion path, thus with the site toggles, stats and tracepoints.
+ */
+#define DBC_REQUIRE_PURE(...)                                                                      \
+    DBC_EXPAND(DBC_GET_MACRO3(__VA_ARGS__, DBC_REQUIRE_PURE3, DBC_REQUIRE_PURE2, )(__VA_ARGS__))
+
+#endif // DBC_MEMO_H
@@ -0,0 +1,269 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_MEMORY_H
+#define DBC_MEMORY_H
+
+#include "dbc/dbc.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <sstream>
+#include <type_traits>
+
+// PURPOSE: Provide pointer precondition macros, that compile to minimal, branch-free, tests on the
+// hot path, and produce a rich decomposition on failure. Macros: DBC_REQUIRE_NOT_NULL,
+// DBC_REQUIRE_ALIGNED, DBC_REQUIRE_NO_OVERLAP, DBC_REQUIRE_IN_BOUNDS
+
+namespace dbc::details
+{
+
+// Returns the address of a pointer.
+/// @private
+template <typename T>
+constexpr auto address(const T* ptr) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>(ptr);
+}
+
+// Returns the byte size of n objects pointed to.
+/// @private
+template <typename T>
+constexpr auto byte_size(const T*, std::size_t n) noexcept
+{
+    if constexpr (std::is_void_v<T>)
+        return n;
+    else
+        return n * sizeof(T);
+}
+
+/// @private
+template <typename T>
+constexpr auto is_not_null(const T* ptr) noexcept
+{
+    return ptr != nullptr;
+}
+
+// Checks whether the alignment is a power of two, and the address a multiple of it.
+/// @private
+template <typename T>
+constexpr auto is_aligned(const T* ptr, std::size_t alignment) noexcept
+{
+    return std::has_single_bit(alignment) & ((address(ptr) & (alignment - 1)) == 0);
+}
+
+// Checks whether [lhs, lhs + lhs_n) and [rhs, rhs + rhs_n) do not overlap. Empty ranges never
+// overlap.
+/// @private
+template <typename T, typename U>
+constexpr auto is_disjoint(const T* lhs, std::size_t lhs_n, const U* rhs,
+                           std::size_t rhs_n) noexcept
+{
+    const auto l = address(lhs), l_size = byte_size(lhs, lhs_n);
+    const auto r = address(rhs), r_size = byte_size(rhs, rhs_n);
+    return (l_size == 0) | (r_size == 0) | (l + l_size <= r) | (r + r_size <= l);
+}
+
+// Checks whether 0 <= index < size, with a single unsigned comparison.
+/// @private
+template <typename Index, typename Size>
+constexpr auto is_in_bounds(Index index, Size size) noexcept
+{
+    static_assert(std::is_integral_v<Index> && std::is_integral_v<Size>);
+
+    using unsigned_type = std::make_unsigned_t<std::common_type_t<Index, Size>>;
+    return static_cast<unsigned_type>(index) < static_cast<unsigned_type>(size);
+}
+
+// Reports a memory contract violation, with the given decomposition.
+/// @private
+inline void handle_memory(const violation_site& site, const std::string& decomposition)
+{
+    handle(make_context(site.type, site.condition, decomposition, site.function, site.file,
+                        site.line, site.message));
+}
+
+// Outputs an address in hex.
+/// @private
+inline auto hex(std::ostream& os, std::uintptr_t addr) -> std::ostream&
+{
+    return os << "0x" << std::hex << addr << std::dec;
+}
+
+/// @private
+DBC_COLD inline void fail_not_null(const violation_site& site, const void*)
+{
+    handle_memory(site, "nullptr");
+}
+
+/// @private
+DBC_COLD inline void fail_aligned(const violation_site& site, const void* ptr,
+                                  std::size_t alignment)
+{
+    std::ostringstream ss;
+    if (!std::has_single_bit(alignment))
+        ss << "alignment " << alignment << " is not a power of two";
+    else
+        hex(ss << "address ", address(ptr))
+            << ", alignment " << alignment << ", remainder " << (address(ptr) & (alignment - 1));
+    handle_memory(site, ss.str());
+}
+
+/// @private
+template <typename T, typename U>
+DBC_COLD void fail_disjoint(const violation_site& site, const T* lhs, std::size_t lhs_n,
+                            const U* rhs, std::size_t rhs_n)
+{
+    const auto l = address(lhs), l_end = l + byte_size(lhs, lhs_n);
+    const auto r = address(rhs), r_end = r + byte_size(rhs, rhs_n);
+
+    std::ostringstream ss;
+    hex(hex(ss << '[', l) << ", ", l_end) << ") overlaps ";
+    hex(hex(ss << '[', r) << ", ", r_end) << ") at ";
+    hex(hex(ss << '[', std::max(l, r)) << ", ", std::min(l_end, r_end)) << ')';
+    handle_memory(site, ss.str());
+}
+
+/// @private
+template <typename Index, typename Size>
+DBC_COLD void fail_in_bounds(const violation_site& site, Index index, Size size)
+{
+    std::ostringstream ss;
+    ss << "index " << index << " out of bounds [0, " << size << ')';
+    handle_memory(site, ss.str());
+}
+
+} // namespace dbc::details
+
+// Evaluates the arguments once, checks them inline, through the common assertion path, and
+// reports failures out of line.
+#define DBC_MEMORY_IMPL(check, condition, msg, ...)                                                \
+    do                                                                                             \
+    {                                                                                              \
+        DBC_SITE_CONDITION(dbc_condition, condition);                                              \
+        static constexpr dbc::violation_site dbc_site{                                             \
+            dbc::contract::precondition, dbc_condition, __FUNCTION__, __FILE__, __LINE__, msg};    \
+        DBC_CHECK_IMPL(dbc::contract::precondition, dbc_condition,                                 \
+                       dbc::details::is_##check(__VA_ARGS__),                                      \
+                       dbc::details::fail_##check(dbc_site, __VA_ARGS__))                          \
+    } while (false)
+
+#if DBC_PRECONDITIONS_ENABLED
+
+#define DBC_REQUIRE_NOT_NULL1(ptr)                                                                 \
+    do                                                                                             \
+    {                                                                                              \
+        const auto* dbc_ptr = (ptr);                                                               \
+        DBC_MEMORY_IMPL(not_null, #ptr " != nullptr", "", dbc_ptr);                                \
+    } while (false)
+
+#define DBC_REQUIRE_NOT_NULL2(ptr, msg)                                                            \
+    do                                                                                             \
+    {                                                                                              \
+        const auto* dbc_ptr = (ptr);                                                               \
+        DBC_MEMORY_IMPL(not_null, #ptr " != nullptr", msg, dbc_ptr);                               \
+    } while (false)
+
+#define DBC_REQUIRE_ALIGNED2(ptr, alignment)                                                       \
+    do                                                                                             \
+    {                                                                                              \
+        const auto* dbc_ptr = (ptr);                                                               \
+        const std::size_t dbc_alignment = (alignment);                                             \
+        DBC_MEMORY_IMPL(aligned, "aligned(" #ptr ", " #alignment ")", "", dbc_ptr, dbc_alignment); \
+    } while (false)
+
+#define DBC_REQUIRE_ALIGNED3(ptr, alignment, msg)                                                  \
+    do                                                                                             \
+    {                                                                                              \
+        const auto* dbc_ptr = (ptr);                                                               \
+        const std::size_t dbc_alignment = (alignment);                                             \
+        DBC_MEMORY_IMPL(aligned, "aligned(" #ptr ", " #alignment ")", msg, dbc_ptr,                \
+                        dbc_alignment);                                                            \
+    } while (false)
+
+#define DBC_REQUIRE_NO_OVERLAP4(lhs, lhs_n, rhs, rhs_n)                                            \
+    DBC_REQUIRE_NO_OVERLAP5(lhs, lhs_n, rhs, rhs_n, "")
+
+#define DBC_REQUIRE_NO_OVERLAP5(lhs, lhs_n, rhs, rhs_n, msg)                                       \
+    do                                                                                             \
+    {                                                                                              \
+        const auto* dbc_lhs = (lhs);                                                               \
+        const std::size_t dbc_lhs_n = (lhs_n);                                                     \
+        const auto* dbc_rhs = (rhs);                                                               \
+        const std::size_t dbc_rhs_n = (rhs_n);                                                     \
+        DBC_MEMORY_IMPL(disjoint,                                                                  \
+                        "no_overlap(" #lhs ", " #lhs_n ", " #rhs ", " #rhs_n ")",                  \
+                        msg, dbc_lhs, dbc_lhs_n, dbc_rhs, dbc_rhs_n);                              \
+    } while (false)
+
+#define DBC_REQUIRE_IN_BOUNDS2(index, size) DBC_REQUIRE_IN_BOUNDS3(index, size, "")
+
+#define DBC_REQUIRE_IN_BOUNDS3(index, size, msg)                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        const auto dbc_index = (index);                                                            \
+        const auto dbc_size = (size);                                                              \
+        DBC_MEMORY_IMPL(in_bounds, "0 <= " #index " < " #size, msg, dbc_index, dbc_size);          \
+    } while (false)
+
+#else
+
+#define DBC_REQUIRE_NOT_NULL1(ptr) DBC_UNCHECKED(dbc::details::is_not_null(ptr))
+#define DBC_REQUIRE_NOT_NULL2(ptr, msg) DBC_UNCHECKED(dbc::details::is_not_null(ptr))
+
+#define DBC_REQUIRE_ALIGNED2(ptr, alignment)                                                       \
+    DBC_UNCHECKED(dbc::details::is_aligned(ptr, alignment))
+#define DBC_REQUIRE_ALIGNED3(ptr, alignment, msg)                                                  \
+    DBC_UNCHECKED(dbc::details::is_aligned(ptr, alignment))
+
+#define DBC_REQUIRE_NO_OVERLAP4(lhs, lhs_n, rhs, rhs_n)                                            \
+    DBC_UNCHECKED(dbc::details::is_disjoint(lhs, lhs_n, rhs, rhs_n))
+#define DBC_REQUIRE_NO_OVERLAP5(lhs, lhs_n, rhs, rhs_n, msg)                                       \
+    DBC_UNCHECKED(dbc::details::is_disjoint(lhs, lhs_n, rhs, rhs_n))
+
+#define DBC_REQUIRE_IN_BOUNDS2(index, size) DBC_UNCHECKED(dbc::details::is_in_bounds(index, size))
+#define DBC_REQUIRE_IN_BOUNDS3(index, size, msg)                                                   \
+    DBC_UNCHECKED(dbc::details::is_in_bounds(index, size))
+
+#endif
+
+#define DBC_REQUIRE_NOT_NULL(...)                                                                  \
+    DBC_EXPAND(                                                                                    \
+        DBC_GET_MACRO(__VA_ARGS__, DBC_REQUIRE_NOT_NULL2, DBC_REQUIRE_NOT_NULL1)(__VA_ARGS__))
+
+#define DBC_REQUIRE_ALIGNED(...)                                                                   \
+    DBC_EXPAND(                                                                                    \
+        DBC_GET_MACRO3(__VA_ARGS__, DBC_REQUIRE_ALIGNED3, DBC_REQUIRE_ALIGNED2, )(__VA_ARGS__))
+
+#define DBC_REQUIRE_NO_OVERLAP(...)                                                                \
+    DBC_EXPAND(DBC_GET_MACRO5(                                                                     \
+        __VA_ARGS__, DBC_REQUIRE_NO_OVERLAP5, DBC_REQUIRE_NO_OVERLAP4, , , )(__VA_ARGS__))
+
+#define DBC_REQUIRE_IN_BOUNDS(...)                                                                 \
+    DBC_EXPAND(                                                                                    \
+        DBC_GET_MACRO3(__VA_ARGS__, DBC_REQUIRE_IN_BOUNDS3, DBC_REQUIRE_IN_BOUNDS2, )(__VA_ARGS__))
+
+#endif // DBC_MEMORY_H
@@ -0,0 +1,630 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_NUMERIC_H
+#define DBC_NUMERIC_H
+
+#include "dbc/parallel.hpp"
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DBC_NUMERIC_X86 1
+#include <immintrin.h>
+#else
+#define DBC_NUMERIC_X86 0
+#endif
+
+// PURPOSE: Provide vectorized whole-array numeric predicates, for invariants over large float,
+// double and integer arrays, e.g. DBC_INVARIANT(dbc::all_finite(std::begin(v), std::end(v))).
+// The widest instruction set available at runtime is picked, with a scalar fallback.
+
+namespace dbc
+{
+
+namespace details
+{
+    // The instruction sets of the numeric kernels, from the narrowest to the widest.
+    /// @private
+    enum class simd_level
+    {
+        scalar,
+        sse2,
+        avx2,
+        avx512
+    };
+
+    /// @private
+    inline auto detect_simd_level() noexcept -> simd_level
+    {
+#if DBC_NUMERIC_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return simd_level::avx512;
+        if (__builtin_cpu_supports("avx2")) return simd_level::avx2;
+        if (__builtin_cpu_supports("sse2")) return simd_level::sse2;
+#endif
+        return simd_level::scalar;
+    }
+
+    // Detected once.
+    /// @private
+    inline auto active_simd_level() noexcept -> simd_level
+    {
+        static const auto level = detect_simd_level();
+        return level;
+    }
+
+    /// @private
+    enum class numeric_check
+    {
+        finite,
+        in_range,
+        monotonic
+    };
+
+    // Returns the index of the first offending element in [begin, n), or n.
+    /// @private
+    template <numeric_check Check, typename T>
+    auto find_scalar(const T* data, std::size_t begin, std::size_t n, T lo, T hi) noexcept
+        -> std::size_t
+    {
+        for (auto i = begin; i < n; ++i)
+        {
+            if constexpr (Check == numeric_check::finite)
+            {
+                if (!std::isfinite(data[i])) return i;
+            }
+            else if constexpr (Check == numeric_check::in_range)
+            {
+                if (!(data[i] >= lo && data[i] <= hi)) return i;
+            }
+            else
+            {
+                if (!(data[i - 1] <= data[i])) return i;
+            }
+        }
+        return n;
+    }
+
+#if DBC_NUMERIC_X86
+
+#define DBC_TARGET_sse2 __attribute__((target("sse2"), always_inline))
+#define DBC_TARGET_avx2 __attribute__((target("avx2"), always_inline))
+#define DBC_TARGET_avx512 __attribute__((target("avx512f"), always_inline))
+
+    // Per instruction set and element type vector operations. The predicates return a bitmask,
+    // with one bit set per offending lane. NaNs are always offending.
+
+    /// @private
+    template <typename T>
+    struct sse2_ops;
+
+    /// @private
+    template <>
+    struct sse2_ops<float>
+    {
+        static constexpr std::size_t lanes{4};
+
+        DBC_TARGET_sse2 static auto load(const float* p) { return _mm_loadu_ps(p); }
+        DBC_TARGET_sse2 static auto set1(float v) { return _mm_set1_ps(v); }
+
+        DBC_TARGET_sse2 static auto not_finite(__m128 v) -> unsigned
+        {
+            const auto d = _mm_sub_ps(v, v); // NaN if v is NaN or infinite
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpunord_ps(d, d)));
+        }
+
+        DBC_TARGET_sse2 static auto out_of_range(__m128 v, __m128 lo, __m128 hi) -> unsigned
+        {
+            return static_cast<unsigned>(
+                _mm_movemask_ps(_mm_or_ps(_mm_cmpnge_ps(v, lo), _mm_cmpnle_ps(v, hi))));
+        }
+
+        DBC_TARGET_sse2 static auto descending(__m128 prev, __m128 v) -> unsigned
+        {
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpnle_ps(prev, v)));
+        }
+    };
+
+    /// @private
+    template <>
+    struct sse2_ops<double>
+    {
+        static constexpr std::size_t lanes{2};
+
+        DBC_TARGET_sse2 static auto load(const double* p) { return _mm_loadu_pd(p); }
+        DBC_TARGET_sse2 static auto set1(double v) { return _mm_set1_pd(v); }
+
+        DBC_TARGET_sse2 static auto not_finite(__m128d v) -> unsigned
+        {
+            const auto d = _mm_sub_pd(v, v);
+            return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpunord_pd(d, d)));
+        }
+
+        DBC_TARGET_sse2 static auto out_of_range(__m128d v, __m128d lo, __m128d hi) -> unsigned
+        {
+            return static_cast<unsigned>(
+                _mm_movemask_pd(_mm_or_pd(_mm_cmpnge_pd(v, lo), _mm_cmpnle_pd(v, hi))));
+        }
+
+        DBC_TARGET_sse2 static auto descending(__m128d prev, __m128d v) -> unsigned
+        {
+            return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpnle_pd(prev, v)));
+        }
+    };
+
+    /// @private
+    template <>
+    struct sse2_ops<std::int32_t>
+    {
+        static constexpr std::size_t lanes{4};
+
+        DBC_TARGET_sse2 static auto load(const std::int32_t* p)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+
+        DBC_TARGET_sse2 static auto set1(std::int32_t v) { return _mm_set1_epi32(v); }
+
+        DBC_TARGET_sse2 static auto out_of_range(__m128i v, __m128i lo, __m128i hi) -> unsigned
+        {
+            const auto mask = _mm_or_si128(_mm_cmpgt_epi32(lo, v), _mm_cmpgt_epi32(v, hi));
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+        }
+
+        DBC_TARGET_sse2 static auto descending(__m128i prev, __m128i v) -> unsigned
+        {
+            return static_cast<unsigned>(
+                _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(prev, v))));
+        }
+    };
+
+    // No 64 bit integer comparisons in SSE2, these fall back to the scalar kernel.
+
+    /// @private
+    template <typename T>
+    struct avx2_ops;
+
+    /// @private
+    template <>
+    struct avx2_ops<float>
+    {
+        static constexpr std::size_t lanes{8};
+
+        DBC_TARGET_avx2 static auto load(const float* p) { return _mm256_loadu_ps(p); }
+        DBC_TARGET_avx2 static auto set1(float v) { return _mm256_set1_ps(v); }
+
+        DBC_TARGET_avx2 static auto not_finite(__m256 v) -> unsigned
+        {
+            const auto d = _mm256_sub_ps(v, v);
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(d, d, _CMP_UNORD_Q)));
+        }
+
+        DBC_TARGET_avx2 static auto out_of_range(__m256 v, __m256 lo, __m256 hi) -> unsigned
+        {
+            const auto mask =
+                _mm256_or_ps(_mm256_cmp_ps(v, lo, _CMP_NGE_UQ), _mm256_cmp_ps(v, hi, _CMP_NLE_UQ));
+            return static_cast<unsigned>(_mm256_movemask_ps(mask));
+        }
+
+        DBC_TARGET_avx2 static auto descending(__m256 prev, __m256 v) -> unsigned
+        {
+            return static_cast<unsigned>(
+                _mm256_movemask_ps(_mm256_cmp_ps(prev, v, _CMP_NLE_UQ)));
+        }
+    };
+
+    /// @private
+    template <>
+    struct avx2_ops<double>
+    {
+        static constexpr std::size_t lanes{4};
+
+        DBC_TARGET_avx2 static auto load(const double* p) { return _mm256_loadu_pd(p); }
+        DBC_TARGET_avx2 static auto set1(double v) { return _mm256_set1_pd(v); }
+
+        DBC_TARGET_avx2 static auto not_finite(__m256d v) -> unsigned
+        {
+            const auto d = _mm256_sub_pd(v, v);
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(d, d, _CMP_UNORD_Q)));
+        }
+
+        DBC_TARGET_avx2 static auto out_of_range(__m256d v, __m256d lo, __m256d hi) -> unsigned
+        {
+            const auto mask =
+                _mm256_or_pd(_mm256_cmp_pd(v, lo, _CMP_NGE_UQ), _mm256_cmp_pd(v, hi, _CMP_NLE_UQ));
+            return static_cast<unsigned>(_mm256_movemask_pd(mask));
+        }
+
+        DBC_TARGET_avx2 static auto descending(__m256d prev, __m256d v) -> unsigned
+        {
+            return static_cast<unsigned>(
+                _mm256_movemask_pd(_mm256_cmp_pd(prev, v, _CMP_NLE_UQ)));
+        }
+    };
+
+    /// @private
+    template <>
+    struct avx2_ops<std::int32_t>
+    {
+        static constexpr std::size_t lanes{8};
+
+        DBC_TARGET_avx2 static auto load(const std::int32_t* p)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        }
+
+        DBC_TARGET_avx2 static auto set1(std::int32_t v) { return _mm256_set1_epi32(v); }
+
+        DBC_TARGET_avx2 static auto out_of_range(__m256i v, __m256i lo, __m256i hi) -> unsigned
+        {
+            const auto mask =
+                _mm256_or_si256(_mm256_cmpgt_epi32(lo, v), _mm256_cmpgt_epi32(v, hi));
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+        }
+
+        DBC_TARGET_avx2 static auto descending(__m256i prev, __m256i v) -> unsigned
+        {
+            return static_cast<unsigned>(
+                _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(prev, v))));
+        }
+    };
+
+    /// @private
+    template <>
+    struct avx2_ops<std::int64_t>
+    {
+        static constexpr std::size_t lanes{4};
+
+        DBC_TARGET_avx2 static auto load(const std::int64_t* p)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        }
+
+        DBC_TARGET_avx2 static auto set1(std::int64_t v) { return _mm256_set1_epi64x(v); }
+
+        DBC_TARGET_avx2 static auto out_of_range(__m256i v, __m256i lo, __m256i hi) -> unsigned
+        {
+            const auto mask =
+                _mm256_or_si256(_mm256_cmpgt_epi64(lo, v), _mm256_cmpgt_epi64(v, hi));
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+        }
+
+        DBC_TARGET_avx2 static auto descending(__m256i prev, __m256i v) -> unsigned
+        {
+            return static_cast<unsigned>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(prev, v))));
+        }
+    };
+
+    /// @private
+    template <typename T>
+    struct avx512_ops;
+
+    /// @private
+    template <>
+    struct avx512_ops<float>
+    {
+        static constexpr std::size_t lanes{16};
+
+        DBC_TARGET_avx512 static auto load(const float* p) { return _mm512_loadu_ps(p); }
+        DBC_TARGET_avx512 static auto set1(float v) { return _mm512_set1_ps(v); }
+
+        DBC_TARGET_avx512 static auto not_finite(__m512 v) -> unsigned
+        {
+            const auto d = _mm512_sub_ps(v, v);
+            return _mm512_cmp_ps_mask(d, d, _CMP_UNORD_Q);
+        }
+
+        DBC_TARGET_avx512 static auto out_of_range(__m512 v, __m512 lo, __m512 hi) -> unsigned
+        {
+            return _mm512_cmp_ps_mask(v, lo, _CMP_NGE_UQ) | _mm512_cmp_ps_mask(v, hi, _CMP_NLE_UQ);
+        }
+
+        DBC_TARGET_avx512 static auto descending(__m512 prev, __m512 v) -> unsigned
+        {
+            return _mm512_cmp_ps_mask(prev, v, _CMP_NLE_UQ);
+        }
+    };
+
+    /// @private
+    template <>
+    struct avx512_ops<double>
+    {
+        static constexpr std::size_t lanes{8};
+
+        DBC_TARGET_avx512 static auto load(const double* p) { return _mm512_loadu_pd(p); }
+        DBC_TARGET_avx512 static auto set1(double v) { return _mm512_set1_pd(v); }
+
+        DBC_TARGET_avx512 static auto not_finite(__m512d v) -> unsigned
+        {
+            const auto d = _mm512_sub_pd(v, v);
+            return _mm512_cmp_pd_mask(d, d, _CMP_UNORD_Q);
+        }
+
+        DBC_TARGET_avx512 static auto out_of_range(__m512d v, __m512d lo, __m512d hi) -> unsigned
+        {
+            return _mm512_cmp_pd_mask(v, lo, _CMP_NGE_UQ) | _mm512_cmp_pd_mask(v, hi, _CMP_NLE_UQ);
+        }
+
+        DBC_TARGET_avx512 static auto descending(__m512d prev, __m512d v) -> unsigned
+        {
+            return _mm512_cmp_pd_mask(prev, v, _CMP_NLE_UQ);
+        }
+    };
+
+    /// @private
+    template <>
+    struct avx512_ops<std::int32_t>
+    {
+        static constexpr std::size_t lanes{16};
+
+        DBC_TARGET_avx512 static auto load(const std::int32_t* p) { return _mm512_loadu_si512(p); }
+        DBC_TARGET_avx512 static auto set1(std::int32_t v) { return _mm512_set1_epi32(v); }
+
+        DBC_TARGET_avx512 static auto out_of_range(__m512i v, __m512i lo, __m512i hi) -> unsigned
+        {
+            return _mm512_cmplt_epi32_mask(v, lo) | _mm512_cmpgt_epi32_mask(v, hi);
+        }
+
+        DBC_TARGET_avx512 static auto descending(__m512i prev, __m512i v) -> unsigned
+        {
+            return _mm512_cmpgt_epi32_mask(prev, v);
+        }
+    };
+
+    /// @private
+    template <>
+    struct avx512_ops<std::int64_t>
+    {
+        static constexpr std::size_t lanes{8};
+
+        DBC_TARGET_avx512 static auto load(const std::int64_t* p) { return _mm512_loadu_si512(p); }
+        DBC_TARGET_avx512 static auto set1(std::int64_t v) { return _mm512_set1_epi64(v); }
+
+        DBC_TARGET_avx512 static auto out_of_range(__m512i v, __m512i lo, __m512i hi) -> unsigned
+        {
+            return _mm512_cmplt_epi64_mask(v, lo) | _mm512_cmpgt_epi64_mask(v, hi);
+        }
+
+        DBC_TARGET_avx512 static auto descending(__m512i prev, __m512i v) -> unsigned
+        {
+            return _mm512_cmpgt_epi64_mask(prev, v);
+        }
+    };
+
+    // Defines the kernel of an instruction set, which tests one vector per iteration, and leaves
+    // the remainder to the scalar kernel. Must be a macro, since the target of a function cannot
+    // depend on a template parameter.
+#define DBC_DEFINE_SIMD_FIND(isa)                                                                  \
+    template <numeric_check Check, typename T>                                                     \
+    __attribute__((target(DBC_TARGET_NAME_##isa))) auto find_##isa(                                \
+        const T* data, std::size_t n, T lo, T hi) noexcept -> std::size_t                          \
+    {                                                                                              \
+        using ops = isa##_ops<T>;                                                                  \
+        const auto vlo = ops::set1(lo);                                                            \
+        const auto vhi = ops::set1(hi);                                                            \
+        std::size_t i = Check == numeric_check::monotonic ? 1 : 0;                                 \
+        for (; i + ops::lanes <= n; i += ops::lanes)                                               \
+        {                                                                                          \
+            const auto v = ops::load(data + i);                                                    \
+            unsigned mask;                                                                         \
+            if constexpr (Check == numeric_check::finite)                                          \
+                mask = ops::not_finite(v);                                                         \
+            else if constexpr (Check == numeric_check::in_range)                                   \
+                mask = ops::out_of_range(v, vlo, vhi);                                             \
+            else                                                                                   \
+                mask = ops::descending(ops::load(data + i - 1), v);                                \
+            if (mask) return i + static_cast<std::size_t>(std::countr_zero(mask));                 \
+        }                                                                                          \
+        return find_scalar<Check>(data, i, n, lo, hi);                                             \
+    }
+
+#define DBC_TARGET_NAME_sse2 "sse2"
+#define DBC_TARGET_NAME_avx2 "avx2"
+#define DBC_TARGET_NAME_avx512 "avx512f"
+
+    /// @private
+    DBC_DEFINE_SIMD_FIND(sse2)
+    /// @private
+    DBC_DEFINE_SIMD_FIND(avx2)
+    /// @private
+    DBC_DEFINE_SIMD_FIND(avx512)
+
+#undef DBC_DEFINE_SIMD_FIND
+#undef DBC_TARGET_NAME_sse2
+#undef DBC_TARGET_NAME_avx2
+#undef DBC_TARGET_NAME_avx512
+#undef DBC_TARGET_sse2
+#undef DBC_TARGET_avx2
+#undef DBC_TARGET_avx512
+
+    /// @private
+    template <template <typename> typename Ops, typename T>
+    concept has_simd_ops = requires { Ops<T>::lanes; };
+
+#endif // DBC_NUMERIC_X86
+
+    // Returns the index of the first offending element in [0, n), or n, with the kernel of the
+    // given instruction set, if supported for T, or the widest narrower one. Vectorized for float,
+    // double, std::int32_t and std::int64_t elements.
+    /// @private
+    template <numeric_check Check, typename T>
+    auto find_offending(simd_level level, const T* data, std::size_t n, T lo = {},
+                        T hi = {}) noexcept -> std::size_t
+    {
+        if (Check == numeric_check::monotonic && n < 2) return n;
+
+#if DBC_NUMERIC_X86
+        if constexpr (has_simd_ops<avx512_ops, T>)
+            if (level >= simd_level::avx512) return find_avx512<Check>(data, n, lo, hi);
+
+        if constexpr (has_simd_ops<avx2_ops, T>)
+            if (level >= simd_level::avx2) return find_avx2<Check>(data, n, lo, hi);
+
+        if constexpr (has_simd_ops<sse2_ops, T>)
+            if (level >= simd_level::sse2) return find_sse2<Check>(data, n, lo, hi);
+#else
+        static_cast<void>(level);
+#endif
+
+        return find_scalar<Check>(data, Check == numeric_check::monotonic ? 1 : 0, n, lo, hi);
+    }
+
+    /// @private
+    template <numeric_check Check, typename T>
+    auto numeric_result(const T* first, const T* last, T lo = {}, T hi = {}) noexcept
+        -> range_result<const T*>
+    {
+        const auto n = static_cast<std::size_t>(last - first);
+        const auto index = find_offending<Check>(active_simd_level(), first, n, lo, hi);
+
+        return {first + index, last, index};
+    }
+
+    /// @private
+    template <typename R>
+    concept contiguous_arithmetic_range = std::ranges::contiguous_range<R> &&
+        std::is_arithmetic_v<std::ranges::range_value_t<R>>;
+
+} // namespace details
+
+/** @defgroup numeric_checking Numeric Checking
+ *  @{
+ */
+
+/**
+ * @brief Checks whether all the elements of an array are finite, i.e. neither infinite nor NaN.
+ *
+ * Vectorized with the widest instruction set available at runtime.
+ *
+ * @param first the beginning of the array
+ * @param last the end of the array
+ *
+ * @return a dbc::range_result, true if all the elements are finite
+ */
+template <std::floating_point T>
+DBC_API auto all_finite(const T* first, const T* last) noexcept -> range_result<const T*>
+{
+    return details::numeric_result<details::numeric_check::finite>(first, last);
+}
+
+/**
+ * @brief Checks whether all the elements of a contiguous range are finite.
+ *
+ * @see dbc::all_finite
+ *
+ * @param r the contiguous range, e.g. a std::vector<double>
+ *
+ * @return a dbc::range_result, true if all the elements are finite
+ */
+template <details::contiguous_arithmetic_range R>
+requires std::floating_point<std::ranges::range_value_t<R>>
+DBC_API auto all_finite(const R& r) noexcept
+{
+    return all_finite(std::ranges::data(r), std::ranges::data(r) + std::ranges::size(r));
+}
+
+/**
+ * @brief Checks whether all the elements of an array are within the closed interval [lo, hi].
+ *
+ * NaNs are never within range. Vectorized with the widest instruction set available at runtime.
+ *
+ * @param first the beginning of the array
+ * @param last the end of the array
+ * @param lo the lower bound
+ * @param hi the upper bound
+ *
+ * @return a dbc::range_result, true if all the elements are within range
+ */
+template <typename T>
+requires std::is_arithmetic_v<T>
+DBC_API auto all_in_range(const T* first, const T* last, std::type_identity_t<T> lo,
+                          std::type_identity_t<T> hi) noexcept -> range_result<const T*>
+{
+    return details::numeric_result<details::numeric_check::in_range>(first, last, lo, hi);
+}
+
+/**
+ * @brief Checks whether all the elements of a contiguous range are within [lo, hi].
+ *
+ * @see dbc::all_in_range
+ *
+ * @param r the contiguous range, e.g. a std::vector<float>
+ * @param lo the lower bound
+ * @param hi the upper bound
+ *
+ * @return a dbc::range_result, true if all the elements are within range
+ */
+template <details::contiguous_arithmetic_range R>
+DBC_API auto all_in_range(const R& r, std::ranges::range_value_t<R> lo,
+                          std::ranges::range_value_t<R> hi) noexcept
+{
+    return all_in_range(std::ranges::data(r), std::ranges::data(r) + std::ranges::size(r), lo, hi);
+}
+
+/**
+ * @brief Checks whether an array is monotonic, i.e. non-decreasing.
+ *
+ * The offending element is the first one less than its predecessor. NaNs are never ordered.
+ * Vectorized with the widest instruction set available at runtime.
+ *
+ * @param first the beginning of the array
+ * @param last the end of the array
+ *
+ * @return a dbc::range_result, true if the array is non-decreasing
+ */
+template <typename T>
+requires std::is_arithmetic_v<T>
+DBC_API auto is_monotonic(const T* first, const T* last) noexcept -> range_result<const T*>
+{
+    return details::numeric_result<details::numeric_check::monotonic>(first, last);
+}
+
+/**
+ * @brief Checks whether a contiguous range is monotonic, i.e. non-decreasing.
+ *
+ * @see dbc::is_monotonic
+ *
+ * @param r the contiguous range, e.g. a std::vector<std::int64_t> of timestamps
+ *
+ * @return a dbc::range_result, true if the range is non-decreasing
+ */
+template <details::contiguous_arithmetic_range R>
+DBC_API auto is_monotonic(const R& r) noexcept
+{
+    return is_monotonic(std::ranges::data(r), std::ranges::data(r) + std::ranges::size(r));
+}
+
+/** @} */
+
+} // namespace dbc
+
+#endif // DBC_NUMERIC_H
@@ -0,0 +1,263 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_PARALLEL_H
+#define DBC_PARALLEL_H
+
+#include "dbc/dbc.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <latch>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+// PURPOSE: Provide whole-range predicates, that split their evaluation accross threads, for
+// expensive contracts over large containers, e.g.
+// DBC_INVARIANT_AUDIT(dbc::all_of(dbc::par, std::begin(v), std::end(v), is_valid)).
+
+namespace dbc
+{
+
+/** @defgroup parallel_checking Parallel Checking
+ *  @{
+ */
+
+/**
+ * @brief An execution policy for the dbc range predicates.
+ *
+ * On default, spreads the evaluation over the hardware threads, by spawning threads per check. An
+ * executor (e.g. a thread pool submit function) can be provided instead, which must eventually run
+ * each submitted task.
+ *
+ */
+DBC_API struct parallel_policy
+{
+    using executor_type = std::function<void(std::function<void()>)>;
+
+    unsigned threads{std::max(std::thread::hardware_concurrency(), 1u)};
+    std::size_t min_chunk{std::size_t{1} << 14}; // elements, below which no threads are used
+    executor_type executor{};
+};
+
+/**
+ * @brief The default parallel execution policy.
+ *
+ */
+DBC_API inline const parallel_policy par{};
+
+/**
+ * @brief The sequential execution policy.
+ *
+ */
+DBC_API inline const parallel_policy seq{1};
+
+/**
+ * @brief The result of a dbc range predicate.
+ * Converts to true if all the elements satisfy the predicate. Otherwise, refers to the first
+ * offending element, which is output by its operator << overload, thus it shows up in the
+ * decomposition of a failed contract.
+ *
+ */
+template <typename Iterator>
+DBC_API struct range_result
+{
+    Iterator offending; // the first offending element, or last
+    Iterator last;
+    std::size_t index;
+
+    constexpr explicit operator bool() const noexcept { return offending == last; }
+};
+
+namespace details
+{
+    /// @private
+    template <typename T>
+    concept streamable = requires(std::ostream& os, const T& v) { os << v; };
+
+} // namespace details
+
+/**
+ * @brief Operator << overload for a dbc::range_result.
+ *
+ * Example output:
+ *
+ * \verbatim
+ * offending element [42]: -7
+ * \endverbatim
+ *
+ */
+template <typename Iterator>
+DBC_API inline auto operator<<(std::ostream& os, const range_result<Iterator>& result)
+    -> std::ostream&
+{
+    if (result) return os << "no offending element";
+
+    os << "offending element [" << result.index << ']';
+
+    if constexpr (details::streamable<std::iter_value_t<Iterator>>) os << ": " << *result.offending;
+
+    return os;
+}
+
+namespace details
+{
+    // Lowers an atomic to the given value, if less.
+    /// @private
+    inline void fetch_min(std::atomic<std::size_t>& target, std::size_t value) noexcept
+    {
+        auto current = target.load(std::memory_order_relaxed);
+        while (value < current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {}
+    }
+
+    // Returns the index of the first element in [first, first + n) not satisfying the predicate,
+    // or n. Each chunk stops early once an offending element is found in a preceding chunk.
+    /// @private
+    template <std::random_access_iterator Iterator, typename Predicate>
+    auto parallel_find_if_not(const parallel_policy& policy, Iterator first, std::size_t n,
+                              Predicate& pred) -> std::size_t
+    {
+        const auto chunks = std::min<std::size_t>(policy.threads, n / policy.min_chunk);
+        if (chunks <= 1)
+        {
+            const auto it = std::find_if_not(first, first + static_cast<std::ptrdiff_t>(n), pred);
+            return static_cast<std::size_t>(it - first);
+        }
+
+        constexpr std::size_t block = 1024; // elements between cancellation polls
+
+        std::atomic<std::size_t> found{n};
+        std::exception_ptr error;
+        std::once_flag error_once;
+
+        auto scan = [&](std::size_t begin, std::size_t end) noexcept {
+            try
+            {
+                for (auto i = begin; i < end && found.load(std::memory_order_relaxed) > i;)
+                {
+                    const auto stop = std::min(i + block, end);
+                    for (; i < stop; ++i)
+                    {
+                        if (!pred(first[static_cast<std::ptrdiff_t>(i)]))
+                        {
+                            fetch_min(found, i);
+                            return;
+                        }
+                    }
+                }
+            } catch (...)
+            {
+                std::call_once(error_once, [&] { error = std::current_exception(); });
+                fetch_min(found, 0); // cancel all
+            }
+        };
+
+        const auto chunk = (n + chunks - 1) / chunks;
+        std::latch done{static_cast<std::ptrdiff_t>(chunks - 1)};
+
+        auto task = [&](std::size_t c) {
+            scan(c * chunk, std::min(n, (c + 1) * chunk));
+            done.count_down();
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            if (!policy.executor) threads.reserve(chunks - 1);
+
+            for (std::size_t c = 1; c < chunks; ++c)
+            {
+                if (policy.executor)
+                    policy.executor([&task, c] { task(c); });
+                else
+                    threads.emplace_back(task, c);
+            }
+
+            scan(0, std::min(n, chunk)); // the calling thread takes the first chunk
+            done.wait();
+        }
+
+        if (error) std::rethrow_exception(error);
+
+        return found.load(std::memory_order_relaxed);
+    }
+
+} // namespace details
+
+/**
+ * @brief Checks whether all the elements of a range satisfy a predicate, in parallel.
+ *
+ * The range is split into chunks, evaluated concurrently. Chunks stop early once an offending
+ * element is found in a preceding chunk, while the first offending element is always reported.
+ * The predicate must be safe to call concurrently. Exceptions thrown from the predicate are
+ * rethrown on the calling thread.
+ *
+ * @param policy the execution policy, e.g. dbc::par
+ * @param first the beginning of the range
+ * @param last the end of the range
+ * @param pred the unary predicate
+ *
+ * @return a dbc::range_result, true if all the elements satisfy the predicate
+ */
+template <std::random_access_iterator Iterator, typename Predicate>
+DBC_API auto all_of(const parallel_policy& policy, Iterator first, Iterator last, Predicate pred)
+    -> range_result<Iterator>
+{
+    const auto n = static_cast<std::size_t>(last - first);
+    const auto index = details::parallel_find_if_not(policy, first, n, pred);
+
+    return {first + static_cast<std::ptrdiff_t>(index), last, index};
+}
+
+/**
+ * @brief Checks whether no element of a range satisfies a predicate, in parallel.
+ *
+ * @see dbc::all_of
+ *
+ * @param policy the execution policy, e.g. dbc::par
+ * @param first the beginning of the range
+ * @param last the end of the range
+ * @param pred the unary predicate
+ *
+ * @return a dbc::range_result, true if no element satisfies the predicate
+ */
+template <std::random_access_iterator Iterator, typename Predicate>
+DBC_API auto none_of(const parallel_policy& policy, Iterator first, Iterator last, Predicate pred)
+    -> range_result<Iterator>
+{
+    return all_of(policy, first, last, [&pred](const auto& v) { return !pred(v); });
+}
+
+/** @} */
+
+} // namespace dbc
+
+#endif // DBC_PARALLEL_H
@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_REGION_H
+#define DBC_REGION_H
+
+#include "dbc/handlers.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+
+// PURPOSE: Provide contract regions, that reduce the violations of the threads of a parallel loop
+// (e.g. std::for_each(std::execution::par, ...) or an OpenMP loop) to a single one, reported once
+// at the region exit, and let the other threads cancel early.
+
+namespace dbc
+{
+
+/** @defgroup contract_regions Contract Regions
+ *  @{
+ */
+
+class contract_region;
+
+/**
+ * @brief The participation of a thread in a dbc::contract_region. Redirects the violations of the
+ * thread into the region, while alive. Nestable.
+ *
+ */
+DBC_API class region_scope
+{
+public:
+    region_scope(const region_scope&) = delete;
+    region_scope(region_scope&&) = delete;
+
+    auto operator=(const region_scope&) -> region_scope& = delete;
+    auto operator=(region_scope&&) -> region_scope& = delete;
+
+    ~region_scope() { details::thread_sink() = m_previous; }
+
+private:
+    friend class contract_region;
+
+    region_scope(contract_region& region, std::size_t index) noexcept; // defined after the region
+
+    static void record(void* self, const violation_context& context); // defined after the region
+
+    contract_region* m_region;
+    std::size_t m_index;
+    details::violation_sink m_previous;
+};
+
+/**
+ * @brief A scope, in which the contract violations of all the participating threads are reduced
+ * to a single one: the first, or the one of the lowest index. The winning violation is reported
+ * once to the set violation handler, at the region exit.
+ *
+ * Threads participate through enter, e.g. per loop iteration. A violation sets a cancellation
+ * flag, which the other threads can poll, to stop early. Since violations are recorded instead of
+ * handled, the participating threads carry on after them, as with a non aborting handler.
+ *
+ */
+DBC_API class contract_region
+{
+public:
+    /**
+     * @brief The index of the participants that are reduced by arrival order.
+     *
+     */
+    static constexpr auto unindexed = std::numeric_limits<std::size_t>::max();
+
+    contract_region() noexcept : m_exceptions{std::uncaught_exceptions()} {}
+
+    contract_region(const contract_region&) = delete;
+    contract_region(contract_region&&) = delete;
+
+    auto operator=(const contract_region&) -> contract_region& = delete;
+    auto operator=(contract_region&&) -> contract_region& = delete;
+
+    /**
+     * @brief Reports the winning violation, if not reported yet, unless unwinding from an exception
+     * thrown inside the region.
+     *
+     */
+    ~contract_region() noexcept(false)
+    {
+        if (std::uncaught_exceptions() == m_exceptions) report();
+    }
+
+    /**
+     * @brief Enters the region, on the calling thread.
+     *
+     * @param index the index of the participant (e.g. the loop iteration), the lowest violated
+     * index wins, or unindexed, for the first violation to win
+     *
+     * @return the participation scope, that redirects the violations of the calling thread into
+     * the region, while alive
+     */
+    [[nodiscard]] auto enter(std::size_t index = unindexed) noexcept -> region_scope
+    {
+        return {*this, index};
+    }
+
+    /**
+     * @brief Checks whether a violation was recorded, thus the participants can stop early.
+     *
+     * @return true if a violation was recorded, false otherwise
+     */
+    auto cancelled() const noexcept -> bool { return m_cancelled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of violations recorded, including the suppressed ones.
+     *
+     * @return the number of violations recorded
+     */
+    auto violations() const noexcept -> std::uint64_t
+    {
+        return m_violations.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Reports the winning violation to the set violation handler, if any, and if not
+     * reported yet. Must be called after all the participants have left the region.
+     *
+     */
+    void report()
+    {
+        std::optional<violation_context> winner;
+        {
+            std::scoped_lock lock{m_mutex};
+            winner.swap(m_winner);
+        }
+
+        if (winner) details::handle(*winner);
+    }
+
+private:
+    friend class region_scope;
+
+    void record(std::size_t index, const violation_context& context)
+    {
+        m_violations.fetch_add(1, std::memory_order_relaxed);
+        m_cancelled.store(true, std::memory_order_relaxed);
+
+        // Unindexed participants are ordered by arrival.
+        const auto key = index == unindexed ? m_arrivals.fetch_add(1, std::memory_order_relaxed)
+                                            : static_cast<std::uint64_t>(index);
+
+        // Lowers the winning key, without locking when losing.
+        auto current = m_winning_key.load(std::memory_order_acquire);
+        while (key < current && !m_winning_key.compare_exchange_weak(current, key)) {}
+        if (key >= current) return;
+
+        std::scoped_lock lock{m_mutex};
+        if (m_winning_key.load(std::memory_order_relaxed) == key) m_winner = context;
+    }
+
+    int m_exceptions;
+    std::atomic<bool> m_cancelled{false};
+    std::atomic<std::uint64_t> m_violations{0};
+    std::atomic<std::uint64_t> m_arrivals{0};
+    std::atomic<std::uint64_t> m_winning_key{std::numeric_limits<std::uint64_t>::max()};
+    std::mutex m_mutex;
+    std::optional<violation_context> m_winner;
+};
+
+inline region_scope::region_scope(contract_region& region, std::size_t index) noexcept
+    : m_region{&region}, m_index{index}, m_previous{details::thread_sink()}
+{
+    details::thread_sink() = {&region_scope::record, this};
+}
+
+inline void region_scope::record(void* self, const violation_context& context)
+{
+    const auto& scope = *static_cast<const region_scope*>(self);
+    scope.m_region->record(scope.m_index, context);
+}
+
+/** @} */
+
+} // namespace dbc
+
+#endif // DBC_REGION_H
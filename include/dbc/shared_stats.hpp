@@ -0,0 +1,501 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_SHARED_STATS_H
+#define DBC_SHARED_STATS_H
+
+#include "dbc/dbc.hpp"
+#include "dbc/details.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "The dbc shared stats require a POSIX platform"
+#endif
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// PURPOSE: Provide host-wide contract evaluation and violation counters, in a shared memory region
+// that is updated by all the processes that map it (e.g. a pre-forked worker fleet), and read live
+// with the dbc_stats tool.
+
+namespace dbc
+{
+
+/** @defgroup shared_stats Shared Stats
+ *  @{
+ */
+
+/**
+ * @brief The counters of a contract site, summed over all the processes, as read back from a
+ * shared stats region.
+ *
+ */
+DBC_API struct shared_stat
+{
+    uint64_t hash; // stable site hash, of the file, line and condition
+    contract type;
+    int32_t line;
+    std::string file;
+    std::string condition;
+    uint64_t evaluations;
+    uint64_t violations;
+};
+
+/**
+ * @brief Operator << overload for a dbc::shared_stat.
+ *
+ * Example output:
+ *
+ * \verbatim
+ * Invariant: x == 0, file: buzz.cpp, line: 100, evaluations: 1200, violations: 3
+ * \endverbatim
+ *
+ */
+DBC_API inline auto operator<<(std::ostream& os, const shared_stat& stat) -> std::ostream&
+{
+    return os << to_string_view(stat.type) << ": " << stat.condition << ", file: " << stat.file
+              << ", line: " << stat.line << ", evaluations: " << stat.evaluations
+              << ", violations: " << stat.violations;
+}
+
+namespace details
+{
+    // Returns a 64 bit FNV-1a hash of a contract site, stable across processes and builds. Never
+    // zero, which marks the empty entries.
+    /// @private
+    constexpr auto site_hash(std::string_view file, int32_t line,
+                             std::string_view condition) noexcept -> uint64_t
+    {
+        uint64_t hash{14695981039346656037ull};
+        auto mix = [&hash](unsigned char byte) { hash = (hash ^ byte) * 1099511628211ull; };
+
+        for (auto c : file) mix(static_cast<unsigned char>(c));
+        mix(0);
+        for (auto i = 0; i < 4; ++i) mix(static_cast<unsigned char>(line >> (8 * i)));
+        for (auto c : condition) mix(static_cast<unsigned char>(c));
+
+        return hash == 0 ? 1 : hash;
+    }
+
+    // The shared stats mapping header. Located at offset 0 of the mapping.
+    /// @private
+    struct alignas(64) stats_header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t capacity; // entries, a power of two
+        std::atomic<uint32_t> used;
+        std::atomic<uint64_t> dropped; // sites that found no free entry
+    };
+
+    // Counters, striped over cache lines, so that processes rarely contend on the same line.
+    /// @private
+    struct alignas(64) stats_stripe
+    {
+        std::atomic<uint64_t> evaluations;
+        std::atomic<uint64_t> violations;
+    };
+
+    /// @private
+    inline constexpr std::size_t stats_stripes = 8;
+
+    // An open addressing hash table entry, claimed by the site hash.
+    /// @private
+    struct alignas(64) stats_entry
+    {
+        std::atomic<uint64_t> hash;  // 0 marks an empty entry
+        std::atomic<uint32_t> ready; // 1 once the description below is written
+        int32_t line;
+        uint8_t type; // a dbc::contract
+        uint8_t reserved[7];
+        char file[104];
+        char condition[128];
+        stats_stripe stripes[stats_stripes];
+    };
+
+    static_assert(sizeof(stats_entry) == 768, "shared stats must keep a fixed layout");
+
+    /// @private
+    inline constexpr char stats_magic[8] = {'D', 'B', 'C', 'S', 'T', 'A', 'T', 'S'};
+
+    /// @private
+    inline constexpr uint32_t stats_version = 1;
+
+    /// @private
+    constexpr auto stats_mapping_size(std::size_t capacity) noexcept
+    {
+        return sizeof(stats_header) + capacity * sizeof(stats_entry);
+    }
+
+    /// @private
+    inline auto stats_entries(stats_header* header) noexcept
+    {
+        return reinterpret_cast<stats_entry*>(header + 1);
+    }
+
+    // The process-wide state of the shared stats. Constant initialized.
+    /// @private
+    struct stats_globals
+    {
+        std::atomic<stats_header*> mapping{nullptr};
+        std::atomic<uint64_t> generation{0}; // bumped per opened region, 0 if none
+        std::atomic<uint32_t> stripe_seed{0}; // changed in forked children
+        std::atomic<uint32_t> next_thread{0};
+    };
+
+    /// @private
+    inline auto shared_stats_globals() noexcept -> stats_globals&
+    {
+        static constinit stats_globals globals;
+        return globals;
+    }
+
+    // Returns the stripe of the calling thread, which differs between forked processes too.
+    /// @private
+    inline auto stats_stripe_index() noexcept -> std::size_t
+    {
+        auto& globals = shared_stats_globals();
+        thread_local const auto thread =
+            globals.next_thread.fetch_add(1, std::memory_order_relaxed);
+
+        return (globals.stripe_seed.load(std::memory_order_relaxed) + thread) % stats_stripes;
+    }
+
+    // Checks whether a claimed entry describes a site, and not another one of the same hash. Waits
+    // for the description to be written, but only for a bounded time, as its writer may have died
+    // in between. The site then claims another entry, which load_shared_stats merges back.
+    /// @private
+    inline auto stats_entry_matches(const stats_entry& e, contract type, std::string_view file,
+                                    int32_t line, std::string_view condition) noexcept -> bool
+    {
+        for (auto spins = 0; e.ready.load(std::memory_order_acquire) != 1; ++spins)
+        {
+            if (spins == 1000) return false;
+            std::this_thread::yield();
+        }
+
+        return e.line == line && e.type == static_cast<uint8_t>(type) &&
+               equals_tail(e.file, file) && equals_head(e.condition, condition);
+    }
+
+    // Finds, or claims, the entry of a site, probing on past the entries of other sites of the same
+    // hash. Returns nullptr if the table is full.
+    /// @private
+    inline auto find_stats_entry(stats_header* header, uint64_t hash, contract type,
+                                 std::string_view file, int32_t line,
+                                 std::string_view condition) noexcept -> stats_entry*
+    {
+        const auto mask = header->capacity - 1;
+        auto* entries = stats_entries(header);
+
+        for (uint32_t probe = 0, i = hash & mask; probe <= mask; ++probe, i = (i + 1) & mask)
+        {
+            auto& e = entries[i];
+            auto current = e.hash.load(std::memory_order_acquire);
+
+            if (current == 0 && e.hash.compare_exchange_strong(current, hash))
+            {
+                e.line = line;
+                e.type = static_cast<uint8_t>(type);
+                copy_tail(e.file, file);
+                copy_head(e.condition, condition);
+                e.ready.store(1, std::memory_order_release);
+                header->used.fetch_add(1, std::memory_order_relaxed);
+                return &e;
+            }
+
+            if (current == hash && stats_entry_matches(e, type, file, line, condition)) return &e;
+        }
+
+        header->dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // The per-site counters handle of a DBC assertion. Constant initialized, resolved to its shared
+    // entry once per opened region.
+    /// @private
+    class shared_stat_site
+    {
+    public:
+        constexpr shared_stat_site(contract type, const char* file, int32_t line,
+                                   const char* condition) noexcept
+            : m_hash{site_hash(file, line, condition)}
+            , m_type{type}
+            , m_file{file}
+            , m_line{line}
+            , m_condition{condition}
+        {}
+
+        void count(bool held) noexcept
+        {
+            const auto generation =
+                shared_stats_globals().generation.load(std::memory_order_acquire);
+            if (m_generation.load(std::memory_order_relaxed) != generation) [[unlikely]]
+                resolve(generation);
+
+            if (auto* e = m_entry.load(std::memory_order_relaxed))
+            {
+                auto& stripe = e->stripes[stats_stripe_index()];
+                stripe.evaluations.fetch_add(1, std::memory_order_relaxed);
+                if (!held) stripe.violations.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        DBC_COLD void resolve(uint64_t generation) noexcept
+        {
+            auto* header = shared_stats_globals().mapping.load(std::memory_order_acquire);
+            m_entry.store(header ? find_stats_entry(header, m_hash, m_type, m_file, m_line,
+                                                    m_condition)
+                                 : nullptr,
+                          std::memory_order_relaxed);
+            m_generation.store(generation, std::memory_order_relaxed);
+        }
+
+        uint64_t m_hash;
+        contract m_type;
+        const char* m_file;
+        int32_t m_line;
+        const char* m_condition;
+        std::atomic<stats_entry*> m_entry{nullptr};
+        std::atomic<uint64_t> m_generation{0};
+    };
+
+} // namespace details
+
+/**
+ * @brief Opens (or creates) a shared stats region, and counts the evaluations and violations of
+ * the DBC assertions into it, from then on. Requires DBC_SHARED_STATS.
+ *
+ * All the processes that open the same file (preferably under /dev/shm), or fork after opening it,
+ * update the same counters, with relaxed atomic increments and no system calls. The region stays
+ * mapped until the process exits. Opening another region redirects the counting to it.
+ *
+ * @param path the backing file path, e.g. /dev/shm/myapp.stats
+ * @param capacity the max number of contract sites, rounded up to a power of two, used only if the
+ * file is created
+ *
+ * @throws std::system_error if the file cannot be created or mapped
+ * @throws std::runtime_error if the file exists, but is not a shared stats file
+ */
+DBC_API inline void open_shared_stats(const std::string& path, std::size_t capacity = 1024)
+{
+    capacity = std::bit_ceil(std::max<std::size_t>(capacity, 1));
+
+    const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd == -1) details::throw_errno("dbc::open_shared_stats: open");
+
+    // Serialize the creation of the region between processes.
+    if (::flock(fd, LOCK_EX) == -1)
+    {
+        ::close(fd);
+        details::throw_errno("dbc::open_shared_stats: flock");
+    }
+
+    auto fail = [fd](const char* what) {
+        const auto error = errno;
+        ::close(fd); // releases the lock
+        errno = error;
+        details::throw_errno(what);
+    };
+
+    struct stat st{};
+    if (::fstat(fd, &st) == -1) fail("dbc::open_shared_stats: fstat");
+
+    const auto created = st.st_size == 0;
+    const auto size =
+        created ? details::stats_mapping_size(capacity) : static_cast<std::size_t>(st.st_size);
+
+    if (created && ::ftruncate(fd, static_cast<off_t>(size)) == -1)
+        fail("dbc::open_shared_stats: ftruncate");
+
+    auto* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) fail("dbc::open_shared_stats: mmap");
+
+    auto* header = static_cast<details::stats_header*>(addr);
+
+    if (created)
+    {
+        // ftruncate zero fills, thus the entries start out empty.
+        ::new (header) details::stats_header{};
+        header->version = details::stats_version;
+        header->capacity = static_cast<uint32_t>(capacity);
+        std::memcpy(header->magic, details::stats_magic, sizeof(header->magic));
+    }
+
+    // The region is initialized, thus other openers may map it. The mapping does not need the file
+    // descriptor, nor the lock.
+    ::flock(fd, LOCK_UN);
+    ::close(fd);
+
+    const auto valid = size >= sizeof(details::stats_header) &&
+                       std::memcmp(header->magic, details::stats_magic, 8) == 0 &&
+                       header->version == details::stats_version &&
+                       std::has_single_bit(header->capacity) &&
+                       details::stats_mapping_size(header->capacity) <= size;
+    if (!valid)
+    {
+        ::munmap(addr, size);
+        throw std::runtime_error{"dbc::open_shared_stats: not a shared stats file"};
+    }
+
+    static const auto fork_handler = ::pthread_atfork(nullptr, nullptr, [] {
+        details::shared_stats_globals().stripe_seed.store(static_cast<uint32_t>(::getpid()),
+                                                          std::memory_order_relaxed);
+    });
+    static_cast<void>(fork_handler);
+
+    auto& globals = details::shared_stats_globals();
+    globals.mapping.store(header, std::memory_order_release);
+    globals.generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Reads the counters of a shared stats file, live.
+ *
+ * @param path the shared stats file path
+ *
+ * @return the counters per contract site, most violated first
+ *
+ * @throws std::system_error if the file cannot be read
+ * @throws std::runtime_error if the file is not a shared stats file
+ */
+DBC_API inline auto load_shared_stats(const std::string& path) -> std::vector<shared_stat>
+{
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) details::throw_errno("dbc::load_shared_stats: open");
+
+    struct stat st{};
+    if (::fstat(fd, &st) == -1)
+    {
+        ::close(fd);
+        details::throw_errno("dbc::load_shared_stats: fstat");
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size < sizeof(details::stats_header))
+    {
+        ::close(fd);
+        throw std::runtime_error{"dbc::load_shared_stats: not a shared stats file"};
+    }
+
+    auto* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) details::throw_errno("dbc::load_shared_stats: mmap");
+
+    auto* header = static_cast<details::stats_header*>(addr);
+
+    const auto valid = std::memcmp(header->magic, details::stats_magic, 8) == 0 &&
+                       header->version == details::stats_version &&
+                       details::stats_mapping_size(header->capacity) <= size;
+    if (!valid)
+    {
+        ::munmap(addr, size);
+        throw std::runtime_error{"dbc::load_shared_stats: not a shared stats file"};
+    }
+
+    std::vector<shared_stat> result;
+    const auto* entries = details::stats_entries(header);
+
+    for (std::size_t i = 0; i < header->capacity; ++i)
+    {
+        const auto& e = entries[i];
+        if (e.ready.load(std::memory_order_acquire) != 1) continue;
+        if (e.type > static_cast<uint8_t>(contract::invariant)) continue; // foreign
+
+        // Bounded, as a foreign file may not null terminate them.
+        shared_stat stat{e.hash.load(std::memory_order_relaxed),
+                         static_cast<contract>(e.type),
+                         e.line,
+                         std::string{details::fixed_view(e.file)},
+                         std::string{details::fixed_view(e.condition)},
+                         0,
+                         0};
+
+        for (const auto& stripe : e.stripes)
+        {
+            stat.evaluations += stripe.evaluations.load(std::memory_order_relaxed);
+            stat.violations += stripe.violations.load(std::memory_order_relaxed);
+        }
+
+        result.push_back(std::move(stat));
+    }
+
+    ::munmap(addr, size);
+
+    // Merges the duplicate entries of a site, claimed while another one was being described.
+    const auto site = [](const shared_stat& s) {
+        return std::tie(s.hash, s.type, s.line, s.file, s.condition);
+    };
+
+    std::sort(std::begin(result), std::end(result),
+              [&site](const auto& l, const auto& r) { return site(l) < site(r); });
+
+    std::vector<shared_stat> merged;
+    for (auto& stat : result)
+    {
+        if (!merged.empty() && site(merged.back()) == site(stat))
+        {
+            merged.back().evaluations += stat.evaluations;
+            merged.back().violations += stat.violations;
+        }
+        else
+            merged.push_back(std::move(stat));
+    }
+    result = std::move(merged);
+
+    std::sort(std::begin(result), std::end(result), [](const auto& l, const auto& r) {
+        return l.violations != r.violations ? l.violations > r.violations
+                                            : l.evaluations > r.evaluations;
+    });
+
+    return result;
+}
+
+/** @} */
+
+} // namespace dbc
+
+#endif // DBC_SHARED_STATS_H
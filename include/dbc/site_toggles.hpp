@@ -0,0 +1,432 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_SITE_TOGGLES_H
+#define DBC_SITE_TOGGLES_H
+
+#include "dbc/dbc.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// PURPOSE: Provide per-site runtime enabling/disabling of the DBC assertions, by glob patterns over
+// their file, function and condition, e.g. DBC_SITES="-condition:*is_sorted*,+file:*/net/*".
+// Opt-in, with the DBC_SITE_TOGGLES definition.
+
+namespace dbc
+{
+
+namespace details
+{
+    /// @private
+    enum class site_state : std::uint8_t
+    {
+        unresolved,
+        enabled,
+        disabled
+    };
+
+    class site_registry;
+
+    // The per-site enable flag of a DBC assertion. Constant initialized, registered and resolved
+    // against the site rules the first time the site is reached. Registered sites are linked in an
+    // intrusive list, so that resolving them does not allocate.
+    /// @private
+    class site_toggle
+    {
+    public:
+        constexpr site_toggle(const char* file, const char* function,
+                              const char* condition) noexcept
+            : m_file{file}, m_function{function}, m_condition{condition}
+        {}
+
+        auto enabled() noexcept -> bool
+        {
+            const auto state = m_state.load(std::memory_order_relaxed);
+            if (state == site_state::enabled) [[likely]] return true;
+            return state == site_state::unresolved && resolve();
+        }
+
+        auto file() const noexcept -> std::string_view { return m_file; }
+        auto function() const noexcept -> std::string_view { return m_function; }
+        auto condition() const noexcept -> std::string_view { return m_condition; }
+
+        void set(bool enabled) noexcept
+        {
+            m_state.store(enabled ? site_state::enabled : site_state::disabled,
+                          std::memory_order_relaxed);
+        }
+
+        auto resolved() const noexcept -> bool
+        {
+            return m_state.load(std::memory_order_relaxed) != site_state::unresolved;
+        }
+
+    private:
+        friend class site_registry;
+
+        auto resolve() noexcept -> bool; // defined after the site registry
+
+        std::atomic<site_state> m_state{site_state::unresolved};
+        const char* m_file;
+        const char* m_function;
+        const char* m_condition;
+        site_toggle* m_next{nullptr}; // the previously registered site
+    };
+
+    // Matches a text against a glob pattern, with * (any sequence) and ? (any character).
+    /// @private
+    constexpr auto glob_match(std::string_view pattern, std::string_view text) noexcept -> bool
+    {
+        std::size_t p{0}, t{0};
+        auto star = std::string_view::npos;
+        std::size_t star_t{0};
+
+        while (t < text.size())
+        {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+            {
+                ++p;
+                ++t;
+            }
+            else if (p < pattern.size() && pattern[p] == '*')
+            {
+                star = p++;
+                star_t = t;
+            }
+            else if (star != std::string_view::npos)
+            {
+                p = star + 1;
+                t = ++star_t;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while (p < pattern.size() && pattern[p] == '*') ++p;
+
+        return p == pattern.size();
+    }
+
+    /// @private
+    enum class site_field
+    {
+        file,
+        function,
+        condition
+    };
+
+    /// @private
+    struct site_rule
+    {
+        site_field field;
+        std::string pattern;
+        bool enable;
+
+        auto matches(const site_toggle& site) const noexcept -> bool
+        {
+            switch (field)
+            {
+            case site_field::function:
+                return glob_match(pattern, site.function());
+            case site_field::condition:
+                return glob_match(pattern, site.condition());
+            default:
+                return glob_match(pattern, site.file());
+            }
+        }
+    };
+
+    // Parses a single rule, e.g. "-function:*parse*". Without a field prefix, the pattern is
+    // matched against the file. Throws std::invalid_argument if the pattern is empty.
+    /// @private
+    inline auto parse_site_rule(std::string_view text) -> site_rule
+    {
+        const auto rule_text = text;
+        site_rule rule{site_field::file, {}, true};
+
+        if (text.starts_with('+') || text.starts_with('-'))
+        {
+            rule.enable = text.front() == '+';
+            text.remove_prefix(1);
+        }
+
+        using namespace std::string_view_literals;
+
+        for (auto [prefix, field] : {std::pair{"file:"sv, site_field::file},
+                                     std::pair{"function:"sv, site_field::function},
+                                     std::pair{"condition:"sv, site_field::condition}})
+        {
+            if (text.starts_with(prefix))
+            {
+                rule.field = field;
+                text.remove_prefix(prefix.size());
+                break;
+            }
+        }
+
+        if (text.empty())
+            throw std::invalid_argument{"dbc: site rule without a pattern: " +
+                                        std::string{rule_text}};
+
+        rule.pattern = text;
+        return rule;
+    }
+
+    // Parses rules separated by commas, semicolons or new lines. Comments start with #.
+    /// @private
+    inline auto parse_site_rules(std::string_view text) -> std::vector<site_rule>
+    {
+        constexpr std::string_view whitespace{" \t\r"};
+
+        std::vector<site_rule> rules;
+        bool comment{false};
+        std::size_t begin{0};
+
+        for (std::size_t i = 0; i <= text.size(); ++i)
+        {
+            const auto end_of_line = i == text.size() || text[i] == '\n';
+            if (!comment && !end_of_line && text[i] != '#' && text[i] != ',' && text[i] != ';')
+                continue;
+
+            if (!comment)
+            {
+                auto entry = text.substr(begin, i - begin);
+                entry.remove_prefix(std::min(entry.find_first_not_of(whitespace), entry.size()));
+                entry.remove_suffix(entry.size() - (entry.find_last_not_of(whitespace) + 1));
+                if (!entry.empty()) rules.push_back(parse_site_rule(entry));
+            }
+
+            comment = !end_of_line && (comment || text[i] == '#');
+            begin = i + 1;
+        }
+
+        return rules;
+    }
+
+    /// @private
+    inline auto read_site_rules(const std::string& path) -> std::vector<site_rule>
+    {
+        std::ifstream file{path};
+        if (!file) throw std::runtime_error{"dbc: cannot open site rules file: " + path};
+
+        const std::string text{std::istreambuf_iterator<char>{file}, {}};
+        if (file.bad()) throw std::runtime_error{"dbc: cannot read site rules file: " + path};
+
+        return parse_site_rules(text);
+    }
+
+    // Reads the rules of the DBC_SITES_FILE and DBC_SITES environment variables. Bad rules are
+    // reported to std::cerr and dropped, thus all the sites are enabled.
+    /// @private
+    inline auto read_env_site_rules() noexcept -> std::vector<site_rule>
+    {
+        try
+        {
+            std::vector<site_rule> rules;
+
+            if (const auto* path = std::getenv("DBC_SITES_FILE")) rules = read_site_rules(path);
+
+            if (const auto* text = std::getenv("DBC_SITES"))
+            {
+                auto parsed = parse_site_rules(text);
+                rules.insert(std::end(rules), std::begin(parsed), std::end(parsed));
+            }
+
+            return rules;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << ", all the sites are enabled\n";
+            return {};
+        }
+    }
+
+    // Holds the site rules and the reached sites. The rules are initialized from the DBC_SITES
+    // (rules) and DBC_SITES_FILE (path to rules) environment variables. The last matching rule
+    // decides the state of a site, which is enabled if no rule matches.
+    //
+    // The reached sites are statics of the code they are in. A shared object whose sites were
+    // reached must not be unloaded (dlclose), as the registry would then link through its memory.
+    /// @private
+    class site_registry
+    {
+    public:
+        static auto instance() noexcept -> site_registry&
+        {
+            static site_registry registry;
+            return registry;
+        }
+
+        auto resolve(site_toggle& site) noexcept -> bool
+        {
+            std::scoped_lock lock{m_mutex};
+
+            if (!site.resolved())
+            {
+                site.m_next = std::exchange(m_sites, &site);
+                site.set(decide(site));
+            }
+
+            return site.enabled();
+        }
+
+        void set_rules(std::vector<site_rule> rules)
+        {
+            std::scoped_lock lock{m_mutex};
+            m_rules = std::move(rules);
+            apply();
+        }
+
+        void add_rule(site_rule rule)
+        {
+            std::scoped_lock lock{m_mutex};
+            m_rules.push_back(std::move(rule));
+            apply();
+        }
+
+    private:
+        site_registry() : m_rules{read_env_site_rules()} {}
+
+        auto decide(const site_toggle& site) const noexcept -> bool
+        {
+            for (auto it = std::rbegin(m_rules); it != std::rend(m_rules); ++it)
+                if (it->matches(site)) return it->enable;
+
+            return true;
+        }
+
+        void apply() noexcept
+        {
+            for (auto* site = m_sites; site; site = site->m_next) site->set(decide(*site));
+        }
+
+        std::mutex m_mutex;
+        std::vector<site_rule> m_rules;
+        site_toggle* m_sites{nullptr}; // the last registered site
+    };
+
+    DBC_COLD inline auto site_toggle::resolve() noexcept -> bool
+    {
+        return site_registry::instance().resolve(*this);
+    }
+
+} // namespace details
+
+/** @defgroup site_toggles Site Toggles
+ *  @{
+ */
+
+/**
+ * @brief Replaces the site rules, and applies them to all the DBC assertions.
+ *
+ * Rules are separated by commas, semicolons or new lines, and have the form:
+ *
+ * \verbatim
+ * [+|-][file:|function:|condition:]glob
+ * \endverbatim
+ *
+ * '-' disables, '+' (the default) enables, the matched sites. Without a field prefix, the glob is
+ * matched against the file. Globs support '*' and '?'. The last matching rule wins, and sites with
+ * no matching rule are enabled. Thus, "-*,+file:*net*" enables the assertions of one module only.
+ * Only the assertions compiled in by the assert level can be enabled.
+ *
+ * As commas separate the rules, a glob cannot contain one. Match the commas of a condition, e.g.
+ * of a call with several arguments, with '?' or '*' instead, e.g. "-condition:in_range(x*y)".
+ *
+ * @param rules the site rules, e.g. "-condition:*is_sorted*"
+ *
+ * @throws std::invalid_argument if a rule has no pattern
+ */
+DBC_API inline void set_site_rules(std::string_view rules)
+{
+    details::site_registry::instance().set_rules(details::parse_site_rules(rules));
+}
+
+/**
+ * @brief Replaces the site rules with the ones of a config file, one per line, with # comments.
+ *
+ * @see dbc::set_site_rules
+ *
+ * @param path the path of the config file
+ *
+ * @throws std::runtime_error if the file cannot be opened or read
+ * @throws std::invalid_argument if a rule has no pattern
+ */
+DBC_API inline void load_site_rules(const std::string& path)
+{
+    details::site_registry::instance().set_rules(details::read_site_rules(path));
+}
+
+/**
+ * @brief Enables the DBC assertions matching a pattern, on top of the current rules.
+ *
+ * @see dbc::set_site_rules
+ *
+ * @param pattern the pattern, e.g. "function:*parse*"
+ *
+ * @throws std::invalid_argument if the pattern is empty
+ */
+DBC_API inline void enable_sites(std::string_view pattern)
+{
+    auto rule = details::parse_site_rule(pattern);
+    rule.enable = true;
+    details::site_registry::instance().add_rule(std::move(rule));
+}
+
+/**
+ * @brief Disables the DBC assertions matching a pattern, on top of the current rules.
+ *
+ * @see dbc::set_site_rules
+ *
+ * @param pattern the pattern, e.g. "condition:*is_sorted*"
+ *
+ * @throws std::invalid_argument if the pattern is empty
+ */
+DBC_API inline void disable_sites(std::string_view pattern)
+{
+    auto rule = details::parse_site_rule(pattern);
+    rule.enable = false;
+    details::site_registry::instance().add_rule(std::move(rule));
+}
+
+/** @} */
+
+} // namespace dbc
+
+#endif // DBC_SITE_TOGGLES_H
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+module;
+
+// The headers of dbc.hpp and dbc_impl.hpp, in the global module fragment, so that only the dbc
+// declarations are part of the module.
+#include "dbc/dbc_macros.hpp"
+#include "dbc/dbc_pch.hpp"
+
+export module dbc;
+
+// PURPOSE: Provide the dbc declarations as a C++20 module, so that they are parsed once, instead of
+// in every translation unit. Modules do not export macros, thus the importers include the
+// macro-only dbc/dbc_macros.hpp header too, after their DBC_ASSERT_LEVEL_* definition:
+//
+//  #define DBC_ASSERT_LEVEL_INVARIANTS
+//  #include "dbc/dbc_macros.hpp"
+//  import dbc;
+//
+// The declarations are attached to the global module, so that the module and the dbc library, if
+// DBC_COMPILED_LIB, agree on their definitions. The macros expand to dbc::details, thus it is
+// exported too.
+
+export extern "C++"
+{
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+}
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_PRECONDITIONS
+#define DBC_SITE_TOGGLES
+
+#include "dbc/arithmetic.hpp"
+#include "dbc/handlers.hpp"
+#include "dbc/site_toggles.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override
+    {
+        dbc::set_violation_handler(noop);
+        dbc::set_site_rules("");
+    }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+
+TEST_F(Given_a_set_handler, Checked_operations_return_the_result_if_in_range)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    const int a{40};
+    const int b{2};
+
+    EXPECT_EQ(DBC_CHECKED_ADD(a, b), 42);
+    EXPECT_EQ(DBC_CHECKED_SUB(a, b), 38);
+    EXPECT_EQ(DBC_CHECKED_MUL(a, b), 80);
+    EXPECT_EQ(DBC_CHECKED_CAST(std::uint8_t, a), 40);
+}
+
+TEST_F(Given_a_set_handler, Checked_operations_have_the_type_of_the_unchecked_ones)
+{
+    const short s{1};
+    const unsigned u{1};
+    const long l{1};
+
+    static_assert(std::is_same_v<decltype(DBC_CHECKED_ADD(s, s)), decltype(s + s)>);
+    static_assert(std::is_same_v<decltype(DBC_CHECKED_SUB(u, s)), decltype(u - s)>);
+    static_assert(std::is_same_v<decltype(DBC_CHECKED_MUL(l, u)), decltype(l * u)>);
+    static_assert(std::is_same_v<decltype(DBC_CHECKED_CAST(short, l)), short>);
+}
+
+TEST_F(Given_a_set_handler, Checked_add_calls_the_handler_with_the_operands_on_overflow)
+{
+    const int max{std::numeric_limits<int>::max()};
+    const int one{1};
+
+    EXPECT_CALL(handler, Call(AllOf(Field(&dbc::violation_context::type,
+                                          dbc::contract::precondition),
+                                    Field(&dbc::violation_context::condition, "max + one"),
+                                    Field(&dbc::violation_context::decomposition,
+                                          "2147483647 + 1 overflows int"))))
+        .Times(1);
+
+    EXPECT_EQ(DBC_CHECKED_ADD(max, one), std::numeric_limits<int>::min());
+}
+
+TEST_F(Given_a_set_handler, Checked_sub_calls_the_handler_on_unsigned_wrap)
+{
+    const unsigned zero{0};
+    const unsigned one{1};
+
+    EXPECT_CALL(handler, Call(AllOf(Field(&dbc::violation_context::condition, "zero - one"),
+                                    Field(&dbc::violation_context::decomposition,
+                                          "0 - 1 overflows unsigned int"))))
+        .Times(1);
+
+    EXPECT_EQ(DBC_CHECKED_SUB(zero, one), std::numeric_limits<unsigned>::max());
+}
+
+TEST_F(Given_a_set_handler, Checked_mul_calls_the_handler_on_overflow)
+{
+    const long long big{std::numeric_limits<long long>::max() / 2 + 1};
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    "4611686018427387904 * 2 overflows long long")))
+        .Times(1);
+
+    DBC_CHECKED_MUL(big, 2);
+}
+
+TEST_F(Given_a_set_handler, Mixed_sign_operations_are_checked_against_the_exact_result)
+{
+    const unsigned u{1};
+    const int minus_two{-2};
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    "1 + -2 overflows unsigned int")))
+        .Times(1);
+
+    DBC_CHECKED_ADD(u, minus_two);
+}
+
+TEST_F(Given_a_set_handler, Checked_casts_call_the_handler_if_not_representable)
+{
+    const int negative{-1};
+    const int large{300};
+
+    EXPECT_CALL(handler, Call(AllOf(Field(&dbc::violation_context::condition,
+                                          "static_cast<unsigned char>(negative)"),
+                                    Field(&dbc::violation_context::decomposition,
+                                          "-1 overflows unsigned char"))))
+        .Times(1);
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    "300 overflows signed char")))
+        .Times(1);
+
+    EXPECT_EQ(DBC_CHECKED_CAST(unsigned char, negative), 255);
+    DBC_CHECKED_CAST(signed char, large);
+    DBC_CHECKED_CAST(long, large);
+}
+
+auto add(int lhs, int rhs) -> int { return DBC_CHECKED_ADD(lhs, rhs); }
+
+TEST_F(Given_a_set_handler, Checked_operations_can_be_disabled_by_function)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::function, "add"))).Times(1);
+    add(std::numeric_limits<int>::max(), 1);
+
+    dbc::set_site_rules("-function:add");
+
+    EXPECT_CALL(handler, Call(_)).Times(0);
+    EXPECT_EQ(add(std::numeric_limits<int>::max(), 1), std::numeric_limits<int>::min());
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_NONE
+#define DBC_ASSUME_UNCHECKED
+
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+auto identity(int x) -> int
+{
+    return x;
+}
+
+auto sum(const int* first, int n) -> int
+{
+    DBC_REQUIRE(first != nullptr);
+    DBC_REQUIRE(n % 4 == 0, "Unrolled by 4");
+
+    auto res = 0;
+    for (auto i = 0; i < n; ++i) res += first[i];
+
+    DBC_ENSURE(res >= 0);
+    return res;
+}
+
+TEST_F(Given_a_set_handler, Assumed_asserts_never_fire)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    DBC_REQUIRE(identity(1) == 1);
+    DBC_ENSURE(identity(2) == 2, "");
+    DBC_INVARIANT(identity(3) == 3);
+}
+
+TEST_F(Given_a_set_handler, Assumed_asserts_keep_the_semantics_of_true_conditions)
+{
+    const int values[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    EXPECT_EQ(sum(values, 8), 36);
+    EXPECT_EQ(sum(values, 4), 10);
+}
+
+TEST_F(Given_a_set_handler, Assumed_asserts_are_never_evaluated)
+{
+    auto evaluated = false;
+    auto evaluate = [&evaluated] { return evaluated = true; };
+
+    DBC_REQUIRE(evaluate());
+    DBC_ENSURE(evaluate(), "");
+    DBC_INVARIANT(evaluate());
+    DBC_REQUIRE_AUDIT(evaluate());
+    DBC_ENSURE_AUDIT(evaluate(), "");
+    DBC_INVARIANT_AXIOM(evaluate());
+
+    EXPECT_FALSE(evaluated);
+}
+
+auto validate([[maybe_unused]] int x) -> dbc::violation
+{
+    DBC_REQUIRE_OR_RETURN(x >= 0);
+    DBC_ENSURE_OR_RETURN(x >= 0, "");
+    DBC_INVARIANT_OR_RETURN(x >= 0);
+    return {};
+}
+
+TEST_F(Given_a_set_handler, Error_return_asserts_are_never_assumed)
+{
+    EXPECT_FALSE(validate(-1));
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_PRECONDITIONS
+#define DBC_ASSERT_AUDIT
+
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+TEST_F(Given_a_set_handler, Audit_precondition_asserts_dont_call_the_handler_if_true)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    DBC_REQUIRE_AUDIT(true);
+}
+
+TEST_F(Given_a_set_handler, Audit_precondition_asserts_call_the_handler_if_false)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(2);
+
+    DBC_REQUIRE_AUDIT(false);
+    DBC_REQUIRE_AUDIT(false, "");
+}
+
+TEST_F(Given_a_set_handler, Audit_asserts_follow_the_assert_level)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    DBC_ENSURE_AUDIT(false);
+    DBC_INVARIANT_AUDIT(false, "");
+}
+
+TEST_F(Given_a_set_handler, Axiom_asserts_never_fire)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    DBC_REQUIRE_AXIOM(false);
+    DBC_ENSURE_AXIOM(false, "");
+    DBC_INVARIANT_AXIOM(false);
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
@@ -27,6 +27,7 @@
 #define DBC_ASSERT_LEVEL_INVARIANTS
 
 #include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -87,6 +88,29 @@ TEST_F(Given_a_set_handler, Invariant_asserts_call_the_handler_if_false)
     DBC_INVARIANT(false);
 }
 
+TEST_F(Given_a_set_handler, Audit_asserts_never_fire_without_audit)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    DBC_REQUIRE_AUDIT(false);
+    DBC_ENSURE_AUDIT(false, "");
+    DBC_INVARIANT_AUDIT(false);
+}
+
+TEST_F(Given_a_set_handler, Axiom_asserts_are_never_evaluated)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    auto evaluated = false;
+    auto evaluate = [&evaluated] { return evaluated = true; };
+
+    DBC_REQUIRE_AXIOM(!evaluate());
+    DBC_ENSURE_AXIOM(!evaluate(), "");
+    DBC_INVARIANT_AXIOM(!evaluate());
+
+    EXPECT_FALSE(evaluated);
+}
+
 } // namespace
 
 auto main(int argc, char* argv[]) -> int
@@ -26,9 +26,15 @@
 
 #define DBC_ASSERT_LEVEL_NONE
 
+#include "dbc/arithmetic.hpp"
+#include "dbc/class_invariant.hpp"
 #include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "dbc/memo.hpp"
+#include "dbc/memory.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <limits>
 
 namespace
 {
@@ -69,6 +75,69 @@ TEST_F(Given_a_set_handler, Invariant_asserts_never_fire)
     DBC_INVARIANT(false, "");
 }
 
+auto validate([[maybe_unused]] int x) -> dbc::violation
+{
+    DBC_REQUIRE_OR_RETURN(x >= 0);
+    DBC_ENSURE_OR_RETURN(x >= 0, "");
+    DBC_INVARIANT_OR_RETURN(x >= 0);
+    return {};
+}
+
+TEST_F(Given_a_set_handler, Error_return_asserts_never_return_early)
+{
+    EXPECT_FALSE(validate(-1));
+}
+
+TEST_F(Given_a_set_handler, Memory_asserts_never_fire)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    [[maybe_unused]] const int* null{nullptr};
+    [[maybe_unused]] const char buffer[2]{};
+
+    DBC_REQUIRE_NOT_NULL(null);
+    DBC_REQUIRE_ALIGNED(buffer + 1, 2);
+    DBC_REQUIRE_NO_OVERLAP(buffer, 2, buffer, 2, "");
+    DBC_REQUIRE_IN_BOUNDS(2, 2);
+}
+
+TEST_F(Given_a_set_handler, Invariant_guards_never_fire)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    struct broken
+    {
+        auto get() const
+        {
+            DBC_INVARIANT_GUARD(value >= 0);
+            return value;
+        }
+
+        int value{-1};
+    };
+
+    EXPECT_EQ(broken{}.get(), -1);
+}
+
+TEST_F(Given_a_set_handler, Memoized_asserts_never_fire)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    [[maybe_unused]] auto is_positive = [](int x) { return x > 0; };
+
+    DBC_REQUIRE_PURE(is_positive, 0);
+}
+
+TEST_F(Given_a_set_handler, Arithmetic_asserts_never_fire)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    const auto max = std::numeric_limits<unsigned>::max();
+
+    EXPECT_EQ(DBC_CHECKED_ADD(max, 1u), 0u);
+    EXPECT_EQ(DBC_CHECKED_CAST(unsigned char, 300), 44);
+}
+
 } // namespace
 
 auto main(int argc, char* argv[]) -> int
@@ -27,6 +27,7 @@
 #define DBC_ASSERT_LEVEL_PRECONDITIONS
 
 #include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <optional>
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+auto validate(int x) -> dbc::violation
+{
+    DBC_REQUIRE_OR_RETURN(x >= 0, "Negative input");
+    DBC_ENSURE_OR_RETURN(x != 1);
+    DBC_INVARIANT_OR_RETURN(x != 2);
+    return {};
+}
+
+// A user defined error-code like result type.
+struct result
+{
+    result(int v) : value{v} {}
+    result(dbc::violation e) : error{e} {}
+
+    std::optional<int> value;
+    dbc::violation error;
+};
+
+auto twice(int x) -> result
+{
+    DBC_REQUIRE_OR_RETURN(x < 100);
+    return 2 * x;
+}
+
+// An error-return assert as the body of an if, with an else.
+auto validate_if(bool check, int x) -> dbc::violation
+{
+    if (check)
+        DBC_REQUIRE_OR_RETURN(x >= 0);
+    else
+        return {};
+
+    return {};
+}
+
+TEST_F(Given_a_set_handler, Error_return_asserts_dont_return_early_if_true)
+{
+    EXPECT_FALSE(validate(42));
+    EXPECT_EQ(validate(42), dbc::violation{});
+}
+
+TEST_F(Given_a_set_handler, Error_return_asserts_return_early_if_false)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(0);
+
+    EXPECT_TRUE(validate(-1));
+    EXPECT_TRUE(validate(1));
+    EXPECT_TRUE(validate(2));
+}
+
+TEST_F(Given_a_set_handler, Error_return_asserts_are_single_statements)
+{
+    EXPECT_TRUE(validate_if(true, -1));
+    EXPECT_FALSE(validate_if(true, 1));
+    EXPECT_FALSE(validate_if(false, -1));
+}
+
+TEST_F(Given_a_set_handler, Error_return_asserts_report_the_violated_site)
+{
+    const auto v = validate(-1);
+    ASSERT_TRUE(v);
+
+    const auto& site = *v.site();
+    EXPECT_EQ(site.type, dbc::contract::precondition);
+    EXPECT_EQ(site.condition, "x >= 0");
+    EXPECT_EQ(site.function, "validate");
+    EXPECT_EQ(site.message, "Negative input");
+
+    EXPECT_EQ(validate(1).site()->type, dbc::contract::postcondition);
+    EXPECT_EQ(validate(2).site()->type, dbc::contract::invariant);
+}
+
+TEST_F(Given_a_set_handler, Error_return_asserts_are_identified_by_site)
+{
+    EXPECT_EQ(validate(-1), validate(-2));
+    EXPECT_NE(validate(-1), validate(1));
+}
+
+TEST_F(Given_a_set_handler, Error_return_asserts_convert_to_user_result_types)
+{
+    EXPECT_EQ(twice(2).value, 4);
+    EXPECT_FALSE(twice(2).error);
+
+    EXPECT_FALSE(twice(100).value);
+    EXPECT_TRUE(twice(100).error);
+}
+
+TEST_F(Given_a_set_handler, Error_return_violations_expand_to_a_context)
+{
+    const auto site = *validate(-1).site();
+    const auto context = validate(-1).context();
+
+    EXPECT_EQ(context.type, site.type);
+    EXPECT_EQ(context.condition, site.condition);
+    EXPECT_EQ(context.decomposition, "");
+    EXPECT_EQ(context.function, site.function);
+    EXPECT_EQ(context.file, site.file);
+    EXPECT_EQ(context.line, site.line);
+    EXPECT_EQ(context.message, site.message);
+}
+
+TEST_F(Given_a_set_handler, Error_return_violations_are_streamable)
+{
+    std::ostringstream os;
+    os << dbc::violation{} << '\n' << validate(-1);
+
+    EXPECT_THAT(os.str(), testing::StartsWith("No violation\nPrecondition: x >= 0, function: "
+                                              "validate, file: "));
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
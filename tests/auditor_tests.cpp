@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/auditor.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <future>
+#include <set>
+#include <thread>
+
+namespace
+{
+
+using namespace std::chrono_literals;
+
+class Given_an_auditor : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+    dbc::auditor auditor{1h}; // audited manually
+};
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+
+TEST_F(Given_an_auditor, Passing_audits_do_not_call_the_handler)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    auto handle = auditor.watch([] { return true; });
+    auditor.audit();
+}
+
+TEST_F(Given_an_auditor, Failing_audits_are_reported_at_the_registration_site)
+{
+    const auto where = std::source_location::current();
+
+    EXPECT_CALL(handler, Call(AllOf(Field(&dbc::violation_context::type, dbc::contract::invariant),
+                                    Field(&dbc::violation_context::condition, "no duplicates"),
+                                    Field(&dbc::violation_context::line, where.line()),
+                                    Field(&dbc::violation_context::message,
+                                          "Background audit failed"))))
+        .Times(1);
+
+    auto handle = auditor.watch([] { return false; }, "no duplicates", where);
+    auditor.audit();
+}
+
+TEST_F(Given_an_auditor, Audits_can_check_with_invariant_assertions)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition, "x == 1"))).Times(1);
+
+    const auto x = 2;
+    auto handle = auditor.watch([&x] { DBC_INVARIANT(x == 1); });
+    auditor.audit();
+}
+
+TEST_F(Given_an_auditor, Audits_run_under_the_given_lock)
+{
+    std::shared_mutex mutex;
+    std::set<int> registry{1, 2, 3};
+
+    auto handle = auditor.watch(mutex, [&] {
+        EXPECT_FALSE(mutex.try_lock()); // held in shared mode
+        return registry.size() == 3;
+    });
+
+    auditor.audit();
+}
+
+TEST_F(Given_an_auditor, Audits_can_check_snapshots)
+{
+    std::mutex mutex;
+    std::vector<int> values{3, 2, 1};
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition, "sorted"))).Times(1);
+
+    auto handle = auditor.watch_snapshot(
+        [&] {
+            std::scoped_lock lock{mutex};
+            return values;
+        },
+        [](const auto& copy) { return std::is_sorted(std::begin(copy), std::end(copy)); },
+        "sorted");
+
+    auditor.audit();
+}
+
+TEST_F(Given_an_auditor, Destroyed_handles_unwatch_their_audits)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    {
+        auto handle = auditor.watch([] { return false; });
+        auditor.audit();
+    }
+
+    auditor.audit();
+}
+
+TEST_F(Given_an_auditor, Running_audits_do_not_block_other_registrations)
+{
+    std::promise<void> started, release;
+
+    auto blocking = auditor.watch([&, done = release.get_future().share()] {
+        started.set_value();
+        done.wait();
+        return true;
+    });
+
+    std::thread pass{[this] { auditor.audit(); }};
+    started.get_future().wait();
+
+    auto other = auditor.watch([] { return true; }); // blocked by the pass if it held the lock
+    other.reset();
+
+    release.set_value();
+    pass.join();
+}
+
+TEST_F(Given_an_auditor, Handlers_can_unwatch_audits)
+{
+    dbc::audit_handle handle;
+
+    EXPECT_CALL(handler, Call(_)).Times(1).WillOnce([&handle](const auto&) { handle.reset(); });
+
+    handle = auditor.watch([] { return false; });
+    auditor.audit();
+    auditor.audit();
+}
+
+TEST_F(Given_an_auditor, Handler_exceptions_are_kept)
+{
+    dbc::set_violation_handler(dbc::throw_handler);
+
+    auto handle = auditor.watch([] { return false; });
+    auditor.audit();
+
+    EXPECT_THROW(std::rethrow_exception(auditor.last_error()), dbc::contract_violation);
+}
+
+TEST_F(Given_an_auditor, Kept_violations_outlive_their_audit)
+{
+    dbc::set_violation_handler(dbc::throw_handler);
+
+    auto handle = auditor.watch([] { return false; }, std::string(64, 'x'));
+    auditor.audit();
+    handle.reset();
+
+    try
+    {
+        std::rethrow_exception(auditor.last_error());
+    } catch (const dbc::contract_violation& e)
+    {
+        EXPECT_EQ(e.context().condition, std::string(64, 'x'));
+    }
+}
+
+TEST(Auditor_thread, Audits_periodically_in_the_background)
+{
+    std::promise<void> reported;
+
+    dbc::set_violation_handler([&reported](const auto&) { reported.set_value(); });
+
+    {
+        dbc::auditor background{1ms};
+        auto handle = background.watch([] { return false; });
+
+        EXPECT_EQ(reported.get_future().wait_for(10s), std::future_status::ready);
+
+        handle.reset(); // no more reports
+    }
+
+    dbc::set_violation_handler(dbc::violation_handler{});
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#define DBC_ASSERT_LEVEL_PRECONDITIONS
+
+#include "dbc/checked_span.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+
+static_assert(std::ranges::contiguous_range<dbc::checked_span<int>>);
+static_assert(std::ranges::borrowed_range<dbc::checked_span<int>>);
+static_assert(std::ranges::view<dbc::checked_span<int>>);
+static_assert(std::is_same_v<dbc::checked_span<int>::iterator, int*>);
+static_assert(
+    std::is_same_v<dbc::checked_span<int>, dbc::checked_preconditions::checked_span<int>>);
+
+TEST_F(Given_a_set_handler, In_bounds_accesses_do_not_call_the_handler)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    std::vector v{1, 2, 3};
+    const dbc::checked_span s{v};
+
+    EXPECT_EQ(s.size(), 3);
+    EXPECT_EQ(s[0] + s[1] + s[2], 6);
+    EXPECT_EQ(s.front(), 1);
+    EXPECT_EQ(s.back(), 3);
+    EXPECT_EQ(std::accumulate(std::begin(s), std::end(s), 0), 6);
+
+    s[1] = 5;
+    EXPECT_EQ(v[1], 5);
+}
+
+TEST_F(Given_a_set_handler, Out_of_bounds_indexing_calls_the_handler)
+{
+    std::vector v{1, 2, 3};
+    const dbc::checked_span s{v};
+
+    EXPECT_CALL(handler,
+                Call(AllOf(Field(&dbc::violation_context::type, dbc::contract::precondition),
+                           Field(&dbc::violation_context::decomposition,
+                                 "index 3 out of bounds [0, 3)"))))
+        .Times(1);
+
+    [[maybe_unused]] const auto* element = &s[3]; // one past the end
+}
+
+TEST_F(Given_a_set_handler, Front_and_back_of_empty_spans_call_the_handler)
+{
+    const dbc::checked_span<int> s;
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message, "front() of an empty span")))
+        .Times(1);
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message, "back() of an empty span")))
+        .Times(1);
+
+    [[maybe_unused]] const auto* front = &s.front();
+    [[maybe_unused]] const auto* back = &s.back();
+}
+
+TEST_F(Given_a_set_handler, Sub_spans_are_checked_once)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    std::array a{1, 2, 3, 4, 5};
+    const dbc::checked_span s{a};
+
+    EXPECT_EQ(s.first(2).size(), 2);
+    EXPECT_EQ(s.last(2)[0], 4);
+    EXPECT_EQ(s.subspan(1, 3).back(), 4);
+    EXPECT_EQ(s.subspan(4).size(), 1);
+    EXPECT_EQ(s.subspan(5).size(), 0);
+}
+
+TEST_F(Given_a_set_handler, Out_of_bounds_sub_spans_call_the_handler)
+{
+    std::array a{1, 2, 3};
+    const dbc::checked_span s{a};
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition, "count <= size()")))
+        .Times(2);
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition, "offset <= size()")))
+        .Times(1);
+    EXPECT_CALL(handler,
+                Call(Field(&dbc::violation_context::condition,
+                           "(count == std::dynamic_extent || count <= size() - offset)")))
+        .Times(1);
+
+    static_cast<void>(s.first(4));
+    static_cast<void>(s.last(4));
+    static_cast<void>(s.subspan(4, 0));
+    static_cast<void>(s.subspan(1, 3));
+}
+
+TEST_F(Given_a_set_handler, Static_extents_are_deduced_and_checked)
+{
+    int raw[4]{};
+    const dbc::checked_span s{raw};
+    static_assert(decltype(s)::extent == 4);
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition, "count == Extent")))
+        .Times(1);
+
+    const dbc::checked_span<int, 4> wrong{raw, 3};
+    const dbc::checked_span<int> dynamic{s};
+    EXPECT_EQ(dynamic.size(), 4);
+}
+
+TEST_F(Given_a_set_handler, Converts_to_and_from_std_span)
+{
+    std::vector v{1, 2, 3};
+    const std::span<int> unchecked = dbc::checked_span{v};
+    const dbc::checked_span<const int> s{unchecked};
+
+    EXPECT_EQ(s.unchecked().data(), v.data());
+    EXPECT_EQ(std::ranges::distance(s | std::views::take(2)), 2);
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
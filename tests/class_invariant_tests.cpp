@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/class_invariant.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+
+// Counts the evaluations of its invariant, 0 <= value.
+class counter
+{
+public:
+    auto get() const -> const int&
+    {
+        DBC_INVARIANT_GUARD(invariant());
+        return m_value;
+    }
+
+    auto get() -> int&
+    {
+        DBC_INVARIANT_GUARD(invariant());
+        return const_cast<int&>(std::as_const(*this).get());
+    }
+
+    void add(int n)
+    {
+        DBC_INVARIANT_GUARD(invariant(), "non negative");
+        get() += n;
+    }
+
+    void set(int n)
+    {
+        DBC_INVARIANT_GUARD(invariant(), "value {}", m_value);
+        m_value = n;
+    }
+
+    void add_then_throw(int n)
+    {
+        DBC_INVARIANT_GUARD(invariant());
+        m_value += n;
+        throw std::runtime_error{"add_then_throw"};
+    }
+
+    void add_to(counter& other, int n)
+    {
+        DBC_INVARIANT_GUARD(invariant());
+        other.add(n);
+    }
+
+    mutable int evaluations{0};
+
+private:
+    auto invariant() const -> bool { return ++evaluations, m_value >= 0; }
+
+    int m_value{0};
+};
+
+TEST_F(Given_a_set_handler, Only_the_outermost_call_is_checked)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    counter c;
+    c.add(1); // add -> get -> const get
+
+    EXPECT_EQ(c.evaluations, 2);
+    EXPECT_EQ(std::as_const(c).get(), 1);
+    EXPECT_EQ(c.evaluations, 4);
+}
+
+TEST_F(Given_a_set_handler, Violations_on_exit_are_reported)
+{
+    EXPECT_CALL(handler, Call(AllOf(Field(&dbc::violation_context::type, dbc::contract::invariant),
+                                    Field(&dbc::violation_context::condition, "invariant()"),
+                                    Field(&dbc::violation_context::function, "add"),
+                                    Field(&dbc::violation_context::message, "non negative"))))
+        .Times(1);
+
+    counter c;
+    c.add(-1);
+}
+
+TEST_F(Given_a_set_handler, Messages_are_formatted_on_violation)
+{
+    EXPECT_CALL(handler, Call(AllOf(Field(&dbc::violation_context::function, "set"),
+                                    Field(&dbc::violation_context::message, "value -2"))))
+        .Times(1);
+
+    counter c;
+    c.set(-2);
+}
+
+TEST_F(Given_a_set_handler, Violations_on_entry_are_reported)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    counter c;
+    c.add(-1);
+
+    EXPECT_CALL(handler, Call(_)).Times(2); // on entry and exit
+    c.add(0);
+}
+
+TEST_F(Given_a_set_handler, Distinct_objects_are_checked_each)
+{
+    counter c, d;
+    c.add_to(d, 1);
+
+    EXPECT_EQ(c.evaluations, 2);
+    EXPECT_EQ(d.evaluations, 2);
+}
+
+TEST_F(Given_a_set_handler, Exit_checks_are_skipped_when_unwinding)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    counter c;
+    EXPECT_THROW(c.add_then_throw(-1), std::runtime_error);
+
+    EXPECT_EQ(c.evaluations, 1);
+}
+
+TEST_F(Given_a_set_handler, Throwing_entry_checks_leave_no_active_guard)
+{
+    dbc::set_violation_handler(dbc::throw_handler);
+
+    counter c;
+    EXPECT_THROW(c.add(-1), dbc::contract_violation); // on exit
+    EXPECT_THROW(c.add(0), dbc::contract_violation);  // on entry
+    EXPECT_THROW(c.add(0), dbc::contract_violation);  // on entry, again
+
+    EXPECT_EQ(dbc::details::active_invariants().size, 0);
+}
+
+TEST_F(Given_a_set_handler, Nesting_is_tracked_per_thread)
+{
+    counter c;
+    std::thread{[&c] { c.add(1); }}.join();
+    c.add(1);
+
+    EXPECT_EQ(c.evaluations, 4);
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
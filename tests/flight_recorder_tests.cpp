@@ -0,0 +1,244 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/flight_recorder.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+class Given_a_flight_recorder : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dbc::set_violation_handler(dbc::make_recording_handler(recorder, handler.AsStdFunction()));
+    }
+
+    void TearDown() override
+    {
+        dbc::set_violation_handler(noop);
+        std::remove(path.c_str());
+    }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    std::string path{testing::TempDir() + "dbc_flight_recorder_tests.bin"};
+    dbc::flight_recorder recorder{path, 4, 3};
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+TEST_F(Given_a_flight_recorder, Violations_are_recorded_and_forwarded)
+{
+    EXPECT_CALL(handler, Call(testing::_)).Times(1);
+
+    DBC_REQUIRE(1 == 2, "What");
+
+    const auto records = dbc::load_flight_records(path);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].sequence, 1);
+    EXPECT_EQ(records[0].type, static_cast<uint8_t>(dbc::contract::precondition));
+    EXPECT_STREQ(records[0].condition, "1 == 2");
+    EXPECT_STREQ(records[0].message, "What");
+    EXPECT_STREQ(records[0].function, "TestBody");
+}
+
+TEST_F(Given_a_flight_recorder, Only_the_last_records_of_a_thread_are_kept)
+{
+    for (auto i = 0; i < 5; ++i) DBC_INVARIANT(i < 0);
+
+    const auto records = dbc::load_flight_records(path);
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0].sequence, 3);
+    EXPECT_EQ(records[1].sequence, 4);
+    EXPECT_EQ(records[2].sequence, 5);
+}
+
+TEST_F(Given_a_flight_recorder, Each_thread_records_into_its_own_ring)
+{
+    DBC_ENSURE(false);
+    std::thread{[] { DBC_ENSURE(false); }}.join();
+
+    const auto records = dbc::load_flight_records(path);
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_NE(records[0].thread_id, records[1].thread_id);
+    EXPECT_EQ(records[0].sequence, 1);
+    EXPECT_EQ(records[1].sequence, 1);
+}
+
+TEST_F(Given_a_flight_recorder, Threads_without_a_free_slot_are_dropped)
+{
+    std::latch recorded{5};
+    std::vector<std::jthread> threads;
+
+    for (auto i = 0; i < 5; ++i)
+    {
+        threads.emplace_back([&recorded] {
+            DBC_ENSURE(false);
+            recorded.arrive_and_wait(); // keep the slots claimed
+        });
+    }
+    threads.clear();
+
+    EXPECT_EQ(dbc::load_flight_records(path).size(), 4);
+    EXPECT_EQ(recorder.dropped(), 1);
+}
+
+TEST_F(Given_a_flight_recorder, Slots_are_released_on_thread_exit)
+{
+    for (auto i = 0; i < 8; ++i) std::thread{[] { DBC_ENSURE(false); }}.join();
+
+    EXPECT_EQ(recorder.dropped(), 0);
+    EXPECT_EQ(dbc::load_flight_records(path).size(), 3);
+}
+
+TEST_F(Given_a_flight_recorder, A_thread_keeps_its_slot_across_recorders)
+{
+    const auto other_path = testing::TempDir() + "dbc_flight_recorder_other.bin";
+    dbc::flight_recorder other{other_path, 1, 3};
+
+    const auto context = dbc::details::make_context(dbc::contract::invariant, "x", "", "f",
+                                                    "a.cpp", 7, "");
+    for (auto i = 0; i < 3; ++i)
+    {
+        recorder.record(context);
+        other.record(context);
+    }
+
+    EXPECT_EQ(other.dropped(), 0);
+
+    const auto records = dbc::load_flight_records(path);
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[2].sequence, 3);
+
+    std::remove(other_path.c_str());
+}
+
+TEST(A_flight_recorder_file, Outlives_the_recorder)
+{
+    const auto path = testing::TempDir() + "dbc_flight_recorder_outlives.bin";
+
+    {
+        dbc::flight_recorder recorder{path};
+        recorder.record(dbc::details::make_context(dbc::contract::invariant, "x", "", "f", "a.cpp",
+                                                   7, ""));
+    }
+
+    const auto records = dbc::load_flight_records(path);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].line, 7);
+
+    std::remove(path.c_str());
+}
+
+TEST(A_flight_recorder_file, Is_validated_on_load)
+{
+    EXPECT_THROW(dbc::load_flight_records("/dev/null"), std::runtime_error);
+    EXPECT_THROW(dbc::load_flight_records("/no/such/file"), std::system_error);
+}
+
+TEST(A_flight_recorder_file, With_corrupt_counts_is_rejected_on_load)
+{
+    const auto path = testing::TempDir() + "dbc_flight_recorder_corrupt.bin";
+
+    {
+        dbc::flight_recorder recorder{path, 1, 1};
+    }
+
+    std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+    const auto threads = uint32_t{0xffffffff};
+    file.seekp(offsetof(dbc::details::flight_header, threads));
+    file.write(reinterpret_cast<const char*>(&threads), sizeof(threads));
+    file.close();
+
+    EXPECT_THROW(dbc::load_flight_records(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST(A_flight_recorder_file, Has_its_strings_terminated_on_load)
+{
+    const auto path = testing::TempDir() + "dbc_flight_recorder_unterminated.bin";
+
+    {
+        dbc::flight_recorder recorder{path, 1, 1};
+        recorder.record(dbc::details::make_context(dbc::contract::invariant, "x", "", "f", "a.cpp",
+                                                   7, ""));
+    }
+
+    // Overwrites the record strings, terminators included.
+    std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+    const std::string garbage(offsetof(dbc::flight_record, message) -
+                                  offsetof(dbc::flight_record, function) +
+                                  sizeof(dbc::flight_record::message),
+                              'x');
+    file.seekp(sizeof(dbc::details::flight_header) + sizeof(dbc::details::flight_slot) +
+               offsetof(dbc::flight_record, function));
+    file.write(garbage.data(), static_cast<std::streamsize>(garbage.size()));
+    file.close();
+
+    const auto records = dbc::load_flight_records(path);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(std::strlen(records[0].function), sizeof(records[0].function) - 1);
+    EXPECT_EQ(std::strlen(records[0].message), sizeof(records[0].message) - 1);
+
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,240 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/fork_checker.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+namespace
+{
+
+using namespace std::chrono_literals;
+
+class Given_a_fork_checker : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+    dbc::fork_checker checker{2};
+};
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+
+TEST_F(Given_a_fork_checker, Passing_checks_do_not_call_the_handler)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    ASSERT_TRUE(checker.check([] { return true; }));
+    checker.wait();
+
+    EXPECT_EQ(checker.running(), 0);
+}
+
+TEST_F(Given_a_fork_checker, Failing_checks_are_reported_at_the_call_site)
+{
+    const auto where = std::source_location::current();
+
+    EXPECT_CALL(handler, Call(AllOf(Field(&dbc::violation_context::type, dbc::contract::invariant),
+                                    Field(&dbc::violation_context::condition, "sorted"),
+                                    Field(&dbc::violation_context::line, where.line()),
+                                    Field(&dbc::violation_context::message,
+                                          "Snapshot check failed"))))
+        .Times(1);
+
+    ASSERT_TRUE(checker.check([] { return false; }, "sorted", where));
+    checker.wait();
+}
+
+TEST_F(Given_a_fork_checker, Checks_can_check_with_invariant_assertions)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message,
+                                    "x == 2, with expansion: 1 == 2")))
+        .Times(1);
+
+    const auto x = 1;
+    ASSERT_TRUE(checker.check([x] { DBC_INVARIANT(x == 2); }));
+    checker.wait();
+}
+
+TEST_F(Given_a_fork_checker, Violated_assertions_report_their_message)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message,
+                                    "x == 2, with expansion: 1 == 2, x is 1")))
+        .Times(1);
+
+    const auto x = 1;
+    ASSERT_TRUE(checker.check([x] { DBC_INVARIANT(x == 2, "x is {}", x); }));
+    checker.wait();
+}
+
+TEST_F(Given_a_fork_checker, Checks_see_a_snapshot_of_the_time_of_the_check)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    std::vector<int> v{1, 2, 3};
+
+    ASSERT_TRUE(checker.check([&v] {
+        std::this_thread::sleep_for(50ms);
+        return v.size() == 3;
+    }));
+
+    v.push_back(4);
+    checker.wait();
+}
+
+TEST_F(Given_a_fork_checker, Checks_past_the_max_children_are_skipped)
+{
+    auto slow = [] {
+        std::this_thread::sleep_for(200ms);
+        return true;
+    };
+
+    ASSERT_TRUE(checker.check(slow));
+    ASSERT_TRUE(checker.check(slow));
+    EXPECT_FALSE(checker.check(slow));
+
+    EXPECT_EQ(checker.running(), 2);
+    EXPECT_EQ(checker.skipped(), 1);
+
+    checker.wait();
+
+    EXPECT_EQ(checker.running(), 0);
+}
+
+TEST_F(Given_a_fork_checker, Abnormally_terminated_checks_are_reported)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message,
+                                    "Snapshot check terminated abnormally")))
+        .Times(1);
+
+    ASSERT_TRUE(checker.check([] {
+        ::_exit(3);
+        return true;
+    }));
+    checker.wait();
+}
+
+TEST_F(Given_a_fork_checker, Hung_checks_are_killed_after_the_timeout)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message, "Snapshot check timed out")))
+        .Times(1);
+
+    dbc::fork_checker timed{1, 100ms};
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(timed.check([] {
+        std::this_thread::sleep_for(1h);
+        return true;
+    }));
+    timed.wait();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 10s);
+    EXPECT_EQ(timed.running(), 0);
+}
+
+TEST_F(Given_a_fork_checker, Checks_reaped_elsewhere_are_reported)
+{
+    EXPECT_CALL(handler, Call(testing::Truly([](const dbc::violation_context& context) {
+                    return context.message.view().starts_with("Snapshot check lost, waitpid: ");
+                })))
+        .Times(1);
+
+    std::signal(SIGCHLD, SIG_IGN); // children are reaped by the kernel
+
+    ASSERT_TRUE(checker.check([] { return true; })); // reported
+    ASSERT_TRUE(checker.check([] {
+        ::_exit(3);
+        return true;
+    }));
+    checker.wait();
+
+    std::signal(SIGCHLD, SIG_DFL);
+}
+
+TEST_F(Given_a_fork_checker, Checks_ignore_the_thread_sink_of_the_forking_thread)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message,
+                                    "x == 2, with expansion: 1 == 2")))
+        .Times(1);
+
+    dbc::details::thread_sink() = {[](void*, const dbc::violation_context&) {}, nullptr};
+
+    const auto x = 1;
+    ASSERT_TRUE(checker.check([x] { DBC_INVARIANT(x == 2); }));
+
+    dbc::details::thread_sink() = {};
+    checker.wait();
+}
+
+TEST_F(Given_a_fork_checker, Finished_checks_are_collected_by_poll)
+{
+    ASSERT_TRUE(checker.check([] { return true; }));
+
+    std::size_t collected{0};
+    for (auto i = 0; i < 100 && collected == 0; ++i)
+    {
+        std::this_thread::sleep_for(10ms);
+        collected = checker.poll();
+    }
+
+    EXPECT_EQ(collected, 1);
+    EXPECT_EQ(checker.running(), 0);
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
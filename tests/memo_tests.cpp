@@ -0,0 +1,297 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#define DBC_ASSERT_LEVEL_PRECONDITIONS
+
+#include "dbc/handlers.hpp"
+#include "dbc/memo.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dbc::set_violation_handler(handler.AsStdFunction());
+        dbc::invalidate_memos();
+    }
+
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+
+struct counted_is_sorted
+{
+    int* calls;
+
+    auto operator()(const std::vector<int>& v) const
+    {
+        ++*calls;
+        return std::is_sorted(std::begin(v), std::end(v));
+    }
+};
+
+TEST_F(Given_a_set_handler, Passing_inputs_are_evaluated_once)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    auto calls = 0;
+    const counted_is_sorted is_sorted{&calls};
+    const std::vector v{1, 2, 3};
+
+    for (auto i = 0; i < 5; ++i) DBC_REQUIRE_PURE(is_sorted, v);
+
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(Given_a_set_handler, Distinct_inputs_are_evaluated_each)
+{
+    auto calls = 0;
+    const counted_is_sorted is_sorted{&calls};
+    const std::vector v{1, 2, 3}, w{4, 5, 6};
+
+    auto require = [&](const auto& input) { DBC_REQUIRE_PURE(is_sorted, input); };
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        require(v);
+        require(w);
+    }
+
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(Given_a_set_handler, Inputs_at_the_address_of_destroyed_ones_are_evaluated)
+{
+    auto calls = 0;
+    const counted_is_sorted is_sorted{&calls};
+
+    auto require = [&](const auto& input) { DBC_REQUIRE_PURE(is_sorted, input); };
+
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    {
+        const std::vector a{1, 2, 3};
+        require(a);
+    }
+    {
+        const std::vector b{3, 2, 1}; // likely in the memory of a
+        require(b);
+    }
+
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(Given_a_set_handler, Equal_inputs_share_their_key)
+{
+    auto calls = 0;
+    const counted_is_sorted is_sorted{&calls};
+    const std::vector v{1, 2, 3}, w{1, 2, 3};
+
+    auto require = [&](const auto& input) { DBC_REQUIRE_PURE(is_sorted, input); };
+
+    require(v);
+    require(w);
+
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(Given_a_set_handler, Views_are_keyed_by_the_data_they_refer_to)
+{
+    auto calls = 0;
+    std::vector v{1, 2, 3};
+    auto is_sorted = [&calls](std::span<const int> s) {
+        return ++calls, std::is_sorted(std::begin(s), std::end(s));
+    };
+
+    auto require = [&] { DBC_REQUIRE_PURE(is_sorted, std::span<const int>{v}); };
+
+    require();
+    v[0] = 9; // mutated behind the same view
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition,
+                                    "is_sorted(std::span<const int>{v})")))
+        .Times(1);
+    require();
+
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(Given_a_set_handler, Ranges_of_hashable_elements_are_keyed_by_their_elements)
+{
+    using dbc::details::memo_key;
+
+    const std::vector<std::string> v{"a", "b"}, w{"a", "b"}, x{"b", "a"};
+
+    EXPECT_EQ(memo_key(v), memo_key(w));
+    EXPECT_NE(memo_key(v), memo_key(x));
+    EXPECT_EQ(memo_key(std::string{"ab"}), memo_key(std::string{"ab"}));
+    EXPECT_NE(memo_key(std::vector{1.0, 2.0}), memo_key(std::vector{2.0, 1.0}));
+}
+
+TEST_F(Given_a_set_handler, Failing_inputs_are_reported_every_time)
+{
+    auto calls = 0;
+    const counted_is_sorted is_sorted{&calls};
+    const std::vector v{3, 2, 1};
+
+    EXPECT_CALL(handler,
+                Call(AllOf(Field(&dbc::violation_context::type, dbc::contract::precondition),
+                           Field(&dbc::violation_context::condition, "is_sorted(v)"),
+                           Field(&dbc::violation_context::message, "What"))))
+        .Times(3);
+
+    for (auto i = 0; i < 3; ++i) DBC_REQUIRE_PURE(is_sorted, v, "What");
+
+    EXPECT_EQ(calls, 3);
+}
+
+TEST_F(Given_a_set_handler, Invalidating_the_memos_forces_a_re_evaluation)
+{
+    auto calls = 0;
+    const counted_is_sorted is_sorted{&calls};
+    std::vector v{1, 2, 3};
+
+    auto require = [&] { DBC_REQUIRE_PURE(is_sorted, v); };
+
+    require();
+    v[0] = 4; // mutated in place
+    dbc::invalidate_memos();
+
+    EXPECT_CALL(handler, Call(_)).Times(1);
+    require();
+
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(Given_a_set_handler, The_oldest_inputs_are_evicted)
+{
+    auto calls = 0;
+    const counted_is_sorted is_sorted{&calls};
+    std::vector<std::vector<int>> inputs;
+    for (auto i = 0; i <= DBC_MEMO_ENTRIES; ++i) inputs.push_back({i, i + 1});
+
+    auto require = [&](const auto& v) { DBC_REQUIRE_PURE(is_sorted, v); };
+
+    for (const auto& v : inputs) require(v);
+    require(inputs.back());
+    EXPECT_EQ(calls, DBC_MEMO_ENTRIES + 1);
+
+    require(inputs.front());
+    EXPECT_EQ(calls, DBC_MEMO_ENTRIES + 2);
+}
+
+TEST_F(Given_a_set_handler, Each_thread_has_its_own_memos)
+{
+    std::atomic_int calls{0};
+    auto is_positive = [&calls](int x) { return ++calls, x > 0; };
+    const auto x = 1;
+
+    auto require = [&] {
+        for (auto i = 0; i < 10; ++i) DBC_REQUIRE_PURE(is_positive, x);
+    };
+
+    std::thread{require}.join();
+    std::thread{require}.join();
+
+    EXPECT_EQ(calls, 2);
+}
+
+} // namespace
+
+namespace versioned
+{
+
+struct table
+{
+    std::vector<int> rows;
+    uint64_t version{0};
+};
+
+auto memo_version(const table& t) noexcept { return t.version; }
+
+auto has_rows(const table& t) { return !t.rows.empty(); }
+
+} // namespace versioned
+
+namespace
+{
+
+TEST_F(Given_a_set_handler, Memo_versions_invalidate_single_inputs)
+{
+    versioned::table t{{1}};
+
+    auto require = [&t] { DBC_REQUIRE_PURE(versioned::has_rows, t); };
+
+    require();
+
+    t.rows.clear();
+    require(); // same version, thus remembered
+
+    ++t.version;
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition, "versioned::has_rows(t)")))
+        .Times(1);
+    require();
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_PRECONDITIONS
+
+#include "dbc/handlers.hpp"
+#include "dbc/memory.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+using testing::HasSubstr;
+
+TEST_F(Given_a_set_handler, Not_null_asserts_call_the_handler_if_null)
+{
+    const int x{};
+    const int* null{nullptr};
+
+    EXPECT_CALL(handler, Call(AllOf(Field(&dbc::violation_context::condition, "null != nullptr"),
+                                    Field(&dbc::violation_context::decomposition, "nullptr"),
+                                    Field(&dbc::violation_context::message, "What"))))
+        .Times(1);
+
+    DBC_REQUIRE_NOT_NULL(&x);
+    DBC_REQUIRE_NOT_NULL(null, "What");
+}
+
+TEST_F(Given_a_set_handler, Aligned_asserts_call_the_handler_if_misaligned)
+{
+    alignas(16) const char buffer[32]{};
+
+    EXPECT_CALL(handler,
+                Call(AllOf(Field(&dbc::violation_context::condition, "aligned(buffer + 4, 16)"),
+                           Field(&dbc::violation_context::decomposition,
+                                 AllOf(HasSubstr("address 0x"),
+                                       HasSubstr(", alignment 16, remainder 4"))))))
+        .Times(1);
+
+    DBC_REQUIRE_ALIGNED(buffer, 16);
+    DBC_REQUIRE_ALIGNED(buffer + 8, 8, "");
+    DBC_REQUIRE_ALIGNED(buffer + 4, 16);
+}
+
+TEST_F(Given_a_set_handler, Aligned_asserts_call_the_handler_if_not_a_power_of_two)
+{
+    alignas(16) const char buffer[32]{};
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    "alignment 0 is not a power of two")))
+        .Times(1);
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    "alignment 12 is not a power of two")))
+        .Times(1);
+
+    DBC_REQUIRE_ALIGNED(buffer, 0);
+    DBC_REQUIRE_ALIGNED(buffer, 12);
+}
+
+TEST_F(Given_a_set_handler, No_overlap_asserts_call_the_handler_if_overlapping)
+{
+    int buffer[16]{};
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    AllOf(HasSubstr(") overlaps ["), HasSubstr(") at [")))))
+        .Times(1);
+
+    DBC_REQUIRE_NO_OVERLAP(buffer, 8, buffer + 8, 8);
+    DBC_REQUIRE_NO_OVERLAP(buffer + 8, 8, buffer, 8, "");
+    DBC_REQUIRE_NO_OVERLAP(buffer, 9, buffer + 8, 8);
+}
+
+TEST_F(Given_a_set_handler, No_overlap_asserts_report_the_overlap_range)
+{
+    const char* base = reinterpret_cast<const char*>(0x1000);
+    const void* other = reinterpret_cast<const void*>(0x1020);
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    "[0x1000, 0x1040) overlaps [0x1020, 0x1060) at "
+                                    "[0x1020, 0x1040)")))
+        .Times(1);
+
+    DBC_REQUIRE_NO_OVERLAP(base, 64, other, 64);
+}
+
+TEST_F(Given_a_set_handler, No_overlap_asserts_never_fire_for_empty_ranges)
+{
+    int buffer[16]{};
+
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    DBC_REQUIRE_NO_OVERLAP(buffer, 0, buffer, 8);
+    DBC_REQUIRE_NO_OVERLAP(buffer, 8, buffer + 4, 0);
+    DBC_REQUIRE_NO_OVERLAP(buffer + 4, 0, buffer + 4, 0);
+}
+
+TEST_F(Given_a_set_handler, In_bounds_asserts_call_the_handler_if_out_of_bounds)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    "index 10 out of bounds [0, 10)")))
+        .Times(1);
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition,
+                                    "index -1 out of bounds [0, 10)")))
+        .Times(1);
+
+    DBC_REQUIRE_IN_BOUNDS(9, 10u);
+    DBC_REQUIRE_IN_BOUNDS(0, 10, "");
+    DBC_REQUIRE_IN_BOUNDS(10, std::size_t{10});
+    DBC_REQUIRE_IN_BOUNDS(-1, 10);
+}
+
+TEST_F(Given_a_set_handler, Memory_asserts_evaluate_their_arguments_once)
+{
+    int buffer[4]{};
+    auto evaluations = 0;
+    auto ptr = [&] {
+        ++evaluations;
+        return buffer;
+    };
+
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    DBC_REQUIRE_NOT_NULL(ptr());
+    DBC_REQUIRE_ALIGNED(ptr(), alignof(int));
+    DBC_REQUIRE_NO_OVERLAP(ptr(), 4, ptr(), 4);
+
+    EXPECT_EQ(evaluations, 4);
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
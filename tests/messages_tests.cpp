@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::_;
+using testing::Field;
+
+struct point
+{
+    int x, y;
+};
+
+auto operator<<(std::ostream& os, const point& p) -> std::ostream&
+{
+    return os << '(' << p.x << ", " << p.y << ')';
+}
+
+enum class color { red = 1, green = 2 };
+
+TEST_F(Given_a_set_handler, Message_arguments_replace_the_braces_on_violation)
+{
+    const int tag{7};
+    const std::string name{"mesh"};
+
+    EXPECT_CALL(handler,
+                Call(Field(&dbc::violation_context::message, "tag 7 (mesh) missing, retry: false")))
+        .Times(1);
+
+    DBC_REQUIRE(tag < 0, "tag {} ({}) missing, retry: {}", tag, name, false);
+}
+
+TEST_F(Given_a_set_handler, Message_arguments_are_not_evaluated_if_the_contract_holds)
+{
+    int evaluated{0};
+    const auto evaluate = [&evaluated] { return ++evaluated; };
+
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    DBC_REQUIRE(true, "{}", evaluate());
+    DBC_ENSURE(true, "{} {}", evaluate(), evaluate());
+    DBC_INVARIANT(true, "{}", evaluate());
+
+    EXPECT_EQ(evaluated, 0);
+}
+
+TEST_F(Given_a_set_handler, Message_arguments_are_formatted_by_type)
+{
+    const char c{'x'};
+    const char* null{nullptr};
+    const void* address{reinterpret_cast<const void*>(0x1f)};
+    const point p{1, 2};
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message,
+                                    "x -3 2 nullptr nullptr 0x1f (1, 2) text")))
+        .Times(1);
+
+    DBC_ENSURE(false, "{} {} {} {} {} {} {} {}", c, -3, color::green, nullptr, null, address,
+               p, "text");
+}
+
+TEST_F(Given_a_set_handler, Message_braces_can_be_escaped)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message, "{} {1} }{")))
+        .Times(1);
+
+    DBC_INVARIANT(false, "{{}} {{{}}} }}{{", 1);
+}
+
+TEST(A_message_format, Counts_its_placeholders_past_the_escaped_braces)
+{
+    using dbc::details::count_placeholders;
+
+    static_assert(count_placeholders("") == 0);
+    static_assert(count_placeholders("{} {}") == 2);
+    static_assert(count_placeholders("{{}} {{{}}} }}{{") == 1);
+    static_assert(count_placeholders("{ } {1} }{") == 0);
+
+    // As with std::format, DBC_REQUIRE(false, "{} {}", 1) does not compile.
+}
+
+TEST_F(Given_a_set_handler, Formatted_messages_are_truncated_to_the_capacity)
+{
+    const std::string long_text(2 * dbc::violation_message::capacity, 'a');
+
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::message,
+                                    std::string(dbc::violation_message::capacity, 'a'))))
+        .Times(1);
+
+    DBC_REQUIRE(false, "{}", long_text);
+}
+
+TEST(A_violation_message, Refers_to_string_literals)
+{
+    constexpr const char* literal{"What"};
+
+    const dbc::violation_message message{literal};
+
+    EXPECT_EQ(message.data(), literal);
+    EXPECT_EQ(message, "What");
+}
+
+TEST(A_violation_message, Owns_a_copy_of_strings)
+{
+    std::string text{"What"};
+
+    const dbc::violation_message message{text};
+    text = "Else";
+
+    EXPECT_EQ(message, "What");
+}
+
+TEST(A_violation_message, Outlives_its_arguments_in_a_thrown_violation)
+{
+    dbc::set_violation_handler(dbc::throw_handler);
+
+    try
+    {
+        const auto tag = std::to_string(42);
+        DBC_REQUIRE(tag.empty(), "Did not find tag: {}", tag);
+        FAIL();
+    } catch (const dbc::contract_violation& e)
+    {
+        EXPECT_EQ(e.context().message, "Did not find tag: 42");
+        EXPECT_STREQ(e.what(), "Did not find tag: 42");
+    }
+
+    dbc::set_violation_handler(dbc::violation_handler{});
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
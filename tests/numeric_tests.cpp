@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/handlers.hpp"
+#include "dbc/numeric.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <limits>
+#include <numeric>
+
+namespace
+{
+
+using dbc::details::find_offending;
+using dbc::details::numeric_check;
+using dbc::details::simd_level;
+
+// The kernels supported by the running cpu.
+auto supported_levels()
+{
+    std::vector<simd_level> levels;
+    for (auto l : {simd_level::scalar, simd_level::sse2, simd_level::avx2, simd_level::avx512})
+        if (l <= dbc::details::active_simd_level()) levels.push_back(l);
+    return levels;
+}
+
+constexpr std::size_t size{67}; // not a multiple of any vector width, to cover the remainders
+
+// Plants an offending value at every index, and checks that each kernel finds it.
+template <numeric_check Check, typename T>
+void expect_each_kernel_finds(T offending, std::type_identity_t<T> lo = {},
+                              std::type_identity_t<T> hi = {})
+{
+    for (auto level : supported_levels())
+    {
+        SCOPED_TRACE(static_cast<int>(level));
+
+        std::vector<T> values(size);
+        std::iota(std::begin(values), std::end(values), T{});
+
+        EXPECT_EQ(find_offending<Check>(level, values.data(), size, lo, hi), size);
+
+        for (auto i = Check == numeric_check::monotonic ? 1u : 0u; i < size; ++i)
+        {
+            auto copy = values;
+            copy[i] = offending;
+            if (i + 1 < size) copy[i + 1] = offending; // later offending elements do not matter
+
+            EXPECT_EQ(find_offending<Check>(level, copy.data(), size, lo, hi), i);
+        }
+    }
+}
+
+TEST(Finite_kernels, Find_the_first_non_finite_element)
+{
+    expect_each_kernel_finds<numeric_check::finite>(std::numeric_limits<float>::quiet_NaN());
+    expect_each_kernel_finds<numeric_check::finite>(std::numeric_limits<float>::infinity());
+    expect_each_kernel_finds<numeric_check::finite>(-std::numeric_limits<double>::infinity());
+    expect_each_kernel_finds<numeric_check::finite>(std::numeric_limits<double>::quiet_NaN());
+}
+
+TEST(In_range_kernels, Find_the_first_element_out_of_range)
+{
+    expect_each_kernel_finds<numeric_check::in_range>(-1.0f, 0.0f, 100.0f);
+    expect_each_kernel_finds<numeric_check::in_range>(101.0, 0.0, 100.0);
+    expect_each_kernel_finds<numeric_check::in_range>(std::numeric_limits<double>::quiet_NaN(),
+                                                      0.0, 100.0);
+    expect_each_kernel_finds<numeric_check::in_range>(std::int32_t{-1}, 0, 100);
+    expect_each_kernel_finds<numeric_check::in_range>(std::int64_t{1} << 40, 0, 100);
+    expect_each_kernel_finds<numeric_check::in_range>(std::uint16_t{200}, 0, 100);
+}
+
+TEST(Monotonic_kernels, Find_the_first_element_less_than_its_predecessor)
+{
+    expect_each_kernel_finds<numeric_check::monotonic>(-1.0f);
+    expect_each_kernel_finds<numeric_check::monotonic>(std::numeric_limits<double>::quiet_NaN());
+    expect_each_kernel_finds<numeric_check::monotonic>(std::int32_t{-1});
+    expect_each_kernel_finds<numeric_check::monotonic>(std::int64_t{-1});
+}
+
+TEST(Monotonic_kernels, Accept_equal_neighbours_and_short_arrays)
+{
+    const std::vector<std::int64_t> timestamps(size, 42);
+
+    EXPECT_TRUE(dbc::is_monotonic(timestamps));
+    EXPECT_TRUE(dbc::is_monotonic(timestamps.data(), timestamps.data() + 1));
+    EXPECT_TRUE(dbc::is_monotonic(timestamps.data(), timestamps.data()));
+}
+
+TEST(Numeric_predicates, Refer_to_the_first_offending_element)
+{
+    std::vector<double> values(1000, 0.5);
+    values[700] = 2.5;
+    values[800] = 3.5;
+
+    const auto res = dbc::all_in_range(values, 0.0, 1.0);
+
+    ASSERT_FALSE(res);
+    EXPECT_EQ(res.index, 700);
+    EXPECT_EQ(*res.offending, 2.5);
+    EXPECT_TRUE(dbc::all_finite(values));
+}
+
+TEST(Numeric_predicates, Decompose_the_first_offending_element)
+{
+    testing::NiceMock<testing::MockFunction<dbc::violation_handler>> handler;
+    dbc::set_violation_handler(handler.AsStdFunction());
+
+    std::vector<float> values(1000, 1.0f);
+    values[123] = -7.0f;
+
+    EXPECT_CALL(handler, Call(testing::Field(&dbc::violation_context::decomposition,
+                                             "offending element [123]: -7")))
+        .Times(1);
+
+    DBC_INVARIANT(dbc::all_in_range(values, 0.0f, 10.0f));
+
+    dbc::set_violation_handler(dbc::violation_handler{});
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/handlers.hpp"
+#include "dbc/parallel.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <numeric>
+
+namespace
+{
+
+class Given_a_large_range : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::iota(std::begin(values), std::end(values), 0);
+        dbc::set_violation_handler(handler.AsStdFunction());
+    }
+
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    const dbc::parallel_policy policy{4, 1024};
+    std::vector<int> values = std::vector<int>(100'000);
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+auto non_negative(int x)
+{
+    return x >= 0;
+}
+
+TEST_F(Given_a_large_range, All_of_is_true_if_all_elements_satisfy_the_predicate)
+{
+    const auto res = dbc::all_of(policy, std::begin(values), std::end(values), non_negative);
+
+    EXPECT_TRUE(res);
+    EXPECT_EQ(res.index, values.size());
+}
+
+TEST_F(Given_a_large_range, All_of_reports_the_first_offending_element)
+{
+    values[70'000] = -2;
+    values[99'999] = -3;
+    values[30'001] = -1;
+
+    const auto res = dbc::all_of(policy, std::begin(values), std::end(values), non_negative);
+
+    ASSERT_FALSE(res);
+    EXPECT_EQ(res.index, 30'001);
+    EXPECT_EQ(*res.offending, -1);
+}
+
+TEST_F(Given_a_large_range, None_of_reports_the_first_offending_element)
+{
+    const auto res = dbc::none_of(policy, std::begin(values), std::end(values),
+                                  [](auto x) { return x > 50'000; });
+
+    ASSERT_FALSE(res);
+    EXPECT_EQ(res.index, 50'001);
+}
+
+TEST_F(Given_a_large_range, Sequential_policies_report_the_first_offending_element)
+{
+    values[3] = -1;
+
+    EXPECT_EQ(dbc::all_of(dbc::seq, std::begin(values), std::end(values), non_negative).index, 3);
+}
+
+TEST_F(Given_a_large_range, Executors_run_the_chunks)
+{
+    std::vector<std::jthread> pool;
+    const dbc::parallel_policy pooled{4, 1024, [&pool](auto task) {
+                                          pool.emplace_back(std::move(task));
+                                      }};
+
+    values[80'000] = -1;
+
+    EXPECT_EQ(dbc::all_of(pooled, std::begin(values), std::end(values), non_negative).index,
+              80'000);
+    EXPECT_EQ(pool.size(), 3);
+}
+
+TEST_F(Given_a_large_range, Predicate_exceptions_are_rethrown)
+{
+    auto throwing = [](int x) {
+        if (x == 60'000) throw std::runtime_error{"What"};
+        return true;
+    };
+
+    EXPECT_THROW(dbc::all_of(policy, std::begin(values), std::end(values), throwing),
+                 std::runtime_error);
+}
+
+TEST_F(Given_a_large_range, Contracts_decompose_the_first_offending_element)
+{
+    values[12'345] = -7;
+
+    EXPECT_CALL(handler, Call(testing::Field(&dbc::violation_context::decomposition,
+                                             "offending element [12345]: -7")))
+        .Times(1);
+
+    DBC_INVARIANT(dbc::all_of(dbc::par, std::begin(values), std::end(values), non_negative));
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#define DBC_ASSERT_LEVEL_PRECONDITIONS
+
+#include "dbc/handlers.hpp"
+#include "dbc/region.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::_;
+using testing::Field;
+
+// Runs body(i) on n threads, each in the region.
+template <typename Body>
+void run_threads(dbc::contract_region& region, int n, Body body, bool indexed)
+{
+    std::vector<std::jthread> threads;
+    for (auto i = 0; i < n; ++i)
+    {
+        threads.emplace_back([&region, &body, i, indexed] {
+            const auto scope = region.enter(indexed ? static_cast<std::size_t>(i)
+                                                    : dbc::contract_region::unindexed);
+            body(i);
+        });
+    }
+}
+
+TEST_F(Given_a_set_handler, Violations_are_reported_once_at_the_region_exit)
+{
+    testing::MockFunction<void()> exited;
+    {
+        testing::InSequence sequence;
+        EXPECT_CALL(exited, Call()).Times(1);
+        EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition, "i < 0"))).Times(1);
+    }
+
+    {
+        dbc::contract_region region;
+        run_threads(region, 8, [](int i) { DBC_REQUIRE(i < 0); }, false);
+
+        EXPECT_TRUE(region.cancelled());
+        EXPECT_EQ(region.violations(), 8);
+        exited.Call();
+    }
+}
+
+TEST_F(Given_a_set_handler, The_lowest_index_wins)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::decomposition, "3 < 3"))).Times(1);
+
+    dbc::contract_region region;
+    run_threads(region, 16, [](int i) { DBC_REQUIRE(i < 3); }, true);
+}
+
+TEST_F(Given_a_set_handler, Regions_without_violations_report_nothing)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    dbc::contract_region region;
+    run_threads(region, 4, [](int i) { DBC_REQUIRE(i >= 0); }, true);
+
+    EXPECT_FALSE(region.cancelled());
+    EXPECT_EQ(region.violations(), 0);
+}
+
+TEST_F(Given_a_set_handler, Violations_outside_the_region_scopes_are_handled_directly)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    dbc::contract_region region;
+    {
+        const auto scope = region.enter();
+    }
+
+    DBC_REQUIRE(1 == 2);
+    EXPECT_FALSE(region.cancelled());
+}
+
+TEST_F(Given_a_set_handler, Inner_regions_report_into_the_outer_region)
+{
+    EXPECT_CALL(handler, Call(Field(&dbc::violation_context::condition, "inner_held"))).Times(1);
+
+    dbc::contract_region outer;
+    {
+        const auto outer_scope = outer.enter();
+
+        dbc::contract_region inner;
+        const auto inner_scope = inner.enter();
+
+        const auto inner_held = false;
+        DBC_REQUIRE(inner_held);
+
+        EXPECT_TRUE(inner.cancelled());
+        EXPECT_FALSE(outer.cancelled());
+    } // the inner region reports, while the outer scope is still alive
+
+    EXPECT_EQ(outer.violations(), 1);
+    outer.report();
+}
+
+TEST_F(Given_a_set_handler, Reports_are_not_repeated)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    dbc::contract_region region;
+    {
+        const auto scope = region.enter();
+        DBC_REQUIRE(1 == 2);
+    }
+
+    region.report();
+    region.report();
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
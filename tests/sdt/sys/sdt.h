@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DBC_TESTS_FAKE_SDT_H
+#define DBC_TESTS_FAKE_SDT_H
+
+#include <string_view>
+#include <vector>
+
+// PURPOSE: Stand in for the systemtap <sys/sdt.h> header, in order to record the fired probes of
+// the tracepoints tests, instead of emitting USDT notes.
+
+struct fired_probe
+{
+    std::string_view name;
+    std::string_view condition;
+    std::string_view file;
+    int type;
+    int line;
+    int held;
+};
+
+inline auto fired_probes() -> std::vector<fired_probe>&
+{
+    static std::vector<fired_probe> probes;
+    return probes;
+}
+
+#define DTRACE_PROBE4(provider, name, a1, a2, a3, a4)                                              \
+    fired_probes().push_back({#name, a1, a2, a3, a4, -1})
+
+#define DTRACE_PROBE5(provider, name, a1, a2, a3, a4, a5)                                          \
+    fired_probes().push_back({#name, a1, a2, a3, a4, a5})
+
+#endif // DBC_TESTS_FAKE_SDT_H
@@ -0,0 +1,253 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+#define DBC_SHARED_STATS
+
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "dbc/memory.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sys/wait.h>
+
+namespace
+{
+
+class Given_a_shared_stats_file : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::remove(path.c_str());
+        dbc::set_violation_handler(noop);
+        dbc::open_shared_stats(path, 16);
+    }
+
+    void TearDown() override { std::remove(path.c_str()); }
+
+    auto find(std::string_view condition) const -> dbc::shared_stat
+    {
+        const auto stats = dbc::load_shared_stats(path);
+        const auto matches = [condition](const auto& s) { return s.condition == condition; };
+        const auto iter = std::find_if(std::begin(stats), std::end(stats), matches);
+
+        return iter != std::end(stats) ? *iter : dbc::shared_stat{};
+    }
+
+    std::string path{testing::TempDir() + "dbc_shared_stats_tests.bin"};
+    dbc::violation_handler noop{[](const auto&) {}};
+};
+
+TEST_F(Given_a_shared_stats_file, Evaluations_and_violations_are_counted)
+{
+    for (auto i = 0; i < 5; ++i) DBC_INVARIANT(i < 3);
+
+    const auto stat = find("i < 3");
+    EXPECT_EQ(stat.type, dbc::contract::invariant);
+    EXPECT_EQ(stat.evaluations, 5);
+    EXPECT_EQ(stat.violations, 2);
+}
+
+TEST_F(Given_a_shared_stats_file, Memory_asserts_are_counted)
+{
+    for (auto i = 0; i < 5; ++i) DBC_REQUIRE_IN_BOUNDS(i, 4);
+
+    const auto stat = find("0 <= i < 4");
+    EXPECT_EQ(stat.type, dbc::contract::precondition);
+    EXPECT_EQ(stat.evaluations, 5);
+    EXPECT_EQ(stat.violations, 1);
+}
+
+TEST_F(Given_a_shared_stats_file, Sites_are_keyed_by_a_stable_hash)
+{
+    const auto x = 1;
+    const auto line = __LINE__ + 1;
+    DBC_REQUIRE(x == 1);
+
+    const auto stat = find("x == 1");
+    EXPECT_EQ(stat.line, line);
+    EXPECT_EQ(stat.hash, dbc::details::site_hash(__FILE__, line, "x == 1"));
+    EXPECT_EQ(stat.evaluations, 1);
+    EXPECT_EQ(stat.violations, 0);
+}
+
+TEST_F(Given_a_shared_stats_file, Sites_of_the_same_hash_get_their_own_entries)
+{
+    using dbc::details::find_stats_entry;
+
+    auto* header = dbc::details::shared_stats_globals().mapping.load();
+    const auto type = dbc::contract::precondition;
+
+    auto* first = find_stats_entry(header, 42, type, "first.cpp", 1, "x == 1");
+    auto* second = find_stats_entry(header, 42, type, "second.cpp", 1, "x == 1");
+
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(find_stats_entry(header, 42, type, "first.cpp", 1, "x == 1"), first);
+    EXPECT_EQ(find_stats_entry(header, 42, type, "second.cpp", 1, "x == 1"), second);
+}
+
+TEST_F(Given_a_shared_stats_file, Duplicate_entries_of_a_site_are_merged_when_loaded)
+{
+    using dbc::details::find_stats_entry;
+
+    auto* header = dbc::details::shared_stats_globals().mapping.load();
+    const auto type = dbc::contract::precondition;
+
+    // As if the process describing the first entry had died before it was done.
+    auto* first = find_stats_entry(header, 42, type, "first.cpp", 1, "x == 1");
+    first->ready.store(0);
+    auto* second = find_stats_entry(header, 42, type, "first.cpp", 1, "x == 1");
+    first->ready.store(1);
+
+    ASSERT_NE(second, first);
+    first->stripes[0].evaluations += 1;
+    second->stripes[1].evaluations += 2;
+
+    const auto stats = dbc::load_shared_stats(path);
+    EXPECT_EQ(std::count_if(std::begin(stats), std::end(stats),
+                            [](const auto& s) { return s.condition == "x == 1"; }),
+              1);
+    EXPECT_EQ(find("x == 1").evaluations, 3);
+}
+
+TEST_F(Given_a_shared_stats_file, Foreign_entries_are_bounded_or_skipped_when_loaded)
+{
+    using dbc::details::find_stats_entry;
+
+    auto* header = dbc::details::shared_stats_globals().mapping.load();
+    const auto type = dbc::contract::precondition;
+
+    auto* unterminated = find_stats_entry(header, 42, type, "first.cpp", 1, "x == 1");
+    std::fill(std::begin(unterminated->condition), std::end(unterminated->condition), 'x');
+    auto* foreign = find_stats_entry(header, 43, type, "second.cpp", 1, "y == 1");
+    foreign->type = 42;
+
+    const auto stats = dbc::load_shared_stats(path);
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats.front().condition, std::string(128, 'x'));
+}
+
+TEST_F(Given_a_shared_stats_file, Forked_processes_count_into_the_same_region)
+{
+    auto run = [] {
+        for (auto i = 0; i < 10; ++i) DBC_ENSURE(i < 5);
+    };
+
+    const auto child = ::fork();
+    ASSERT_NE(child, -1);
+
+    if (child == 0)
+    {
+        run();
+        ::_exit(0);
+    }
+
+    run();
+
+    auto status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+
+    const auto stat = find("i < 5");
+    EXPECT_EQ(stat.evaluations, 20);
+    EXPECT_EQ(stat.violations, 10);
+}
+
+TEST_F(Given_a_shared_stats_file, Reopening_it_keeps_the_counters)
+{
+    for (auto i = 0; i < 2; ++i)
+    {
+        dbc::open_shared_stats(path);
+        DBC_INVARIANT(i < 0);
+    }
+
+    const auto stat = find("i < 0");
+    EXPECT_EQ(stat.evaluations, 2);
+    EXPECT_EQ(stat.violations, 2);
+}
+
+TEST_F(Given_a_shared_stats_file, Sites_past_the_capacity_are_not_counted)
+{
+    // The region has 16 entries.
+    DBC_INVARIANT(0);
+    DBC_INVARIANT(1);
+    DBC_INVARIANT(2);
+    DBC_INVARIANT(3);
+    DBC_INVARIANT(4);
+    DBC_INVARIANT(5);
+    DBC_INVARIANT(6);
+    DBC_INVARIANT(7);
+    DBC_INVARIANT(8);
+    DBC_INVARIANT(9);
+    DBC_INVARIANT(10);
+    DBC_INVARIANT(11);
+    DBC_INVARIANT(12);
+    DBC_INVARIANT(13);
+    DBC_INVARIANT(14);
+    DBC_INVARIANT(15);
+    DBC_INVARIANT(16);
+
+    EXPECT_EQ(dbc::load_shared_stats(path).size(), 16);
+}
+
+TEST(A_shared_stats_file, Is_validated_when_loaded)
+{
+    const auto path = testing::TempDir() + "dbc_shared_stats_tests_invalid.bin";
+    std::ofstream{path} << std::string(512, 'x');
+
+    EXPECT_THROW(dbc::load_shared_stats(path), std::runtime_error);
+    EXPECT_THROW(dbc::open_shared_stats(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
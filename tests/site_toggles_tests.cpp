@@ -0,0 +1,297 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+#define DBC_SITE_TOGGLES
+
+#include "dbc/class_invariant.hpp"
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "dbc/memo.hpp"
+#include "dbc/memory.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override { dbc::set_violation_handler(handler.AsStdFunction()); }
+    void TearDown() override
+    {
+        dbc::set_violation_handler(noop);
+        dbc::set_site_rules("");
+    }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::_;
+using testing::HasSubstr;
+
+void check_positive(int x)
+{
+    DBC_REQUIRE(x > 0);
+}
+
+void check_max(int x)
+{
+    DBC_REQUIRE(std::max(x, 1) > 1);
+}
+
+void check_sorted(bool is_sorted)
+{
+    DBC_INVARIANT(is_sorted, "Not sorted");
+}
+
+void check_not_null(const int* ptr)
+{
+    DBC_REQUIRE_NOT_NULL(ptr);
+}
+
+auto is_positive(int x) -> bool { return x > 0; }
+
+void check_pure(int x)
+{
+    DBC_REQUIRE_PURE(is_positive, x);
+}
+
+auto checked_or_return(int x) -> dbc::violation
+{
+    DBC_ENSURE_OR_RETURN(x > 0);
+    return {};
+}
+
+struct guarded
+{
+    void check_guarded() { DBC_INVARIANT_GUARD(valid); }
+
+    bool valid{false};
+};
+
+TEST_F(Given_a_set_handler, Sites_are_enabled_on_default)
+{
+    EXPECT_CALL(handler, Call(_)).Times(2);
+
+    check_positive(0);
+    check_sorted(false);
+}
+
+TEST_F(Given_a_set_handler, Sites_can_be_disabled_by_condition)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    dbc::disable_sites("condition:is_sorted");
+
+    check_positive(0);
+    check_sorted(false);
+}
+
+TEST_F(Given_a_set_handler, Conditions_with_commas_are_matched_by_globs)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    dbc::set_site_rules("-condition:std::max(x*1) > 1");
+
+    check_max(0);
+}
+
+TEST_F(Given_a_set_handler, Sites_can_be_disabled_by_function)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    dbc::disable_sites("function:check_pos*");
+
+    check_positive(0);
+    check_sorted(false);
+}
+
+TEST_F(Given_a_set_handler, Sites_can_be_disabled_by_file)
+{
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    dbc::disable_sites("*site_toggles_tests.cpp");
+
+    check_positive(0);
+    check_sorted(false);
+    EXPECT_FALSE(checked_or_return(0));
+}
+
+TEST_F(Given_a_set_handler, Invariant_guards_can_be_disabled_by_function)
+{
+    EXPECT_CALL(handler, Call(_)).Times(2); // on entry and exit
+
+    guarded g;
+    g.check_guarded();
+
+    dbc::disable_sites("function:check_guarded");
+    g.check_guarded();
+}
+
+TEST_F(Given_a_set_handler, Memory_sites_can_be_disabled_by_condition)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    check_not_null(nullptr);
+    dbc::disable_sites("condition:ptr != nullptr");
+    check_not_null(nullptr);
+}
+
+TEST_F(Given_a_set_handler, Pure_sites_can_be_disabled_by_condition)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    check_pure(0);
+    dbc::disable_sites("condition:is_positive(x)");
+    check_pure(0);
+}
+
+TEST_F(Given_a_set_handler, Sites_can_be_enabled_again_at_runtime)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    check_sorted(true); // resolved before the rules change
+    dbc::disable_sites("condition:is_sorted");
+    check_sorted(false);
+    dbc::enable_sites("condition:is_sorted");
+    check_sorted(false);
+}
+
+TEST_F(Given_a_set_handler, The_last_matching_rule_wins)
+{
+    EXPECT_CALL(handler, Call(_)).Times(1);
+
+    dbc::set_site_rules("-*, +function:check_sorted");
+
+    check_positive(0);
+    check_sorted(false);
+    EXPECT_FALSE(checked_or_return(0));
+}
+
+TEST_F(Given_a_set_handler, Rules_can_be_loaded_from_a_config_file)
+{
+    const auto path = testing::TempDir() + "dbc_site_rules.txt";
+    std::ofstream{path} << "# Noisy checks\n"
+                           "-condition:x > 0   # positives\n"
+                           "\n"
+                           "-condition:is_?orted\n";
+
+    EXPECT_CALL(handler, Call(_)).Times(0);
+
+    dbc::load_site_rules(path);
+    std::remove(path.c_str());
+
+    check_positive(0);
+    check_sorted(false);
+    EXPECT_FALSE(checked_or_return(0)); // same condition
+}
+
+TEST(Site_rules, Missing_config_files_throw)
+{
+    EXPECT_THROW(dbc::load_site_rules("/nonexistent/dbc_site_rules.txt"), std::runtime_error);
+}
+
+TEST(Site_rules, Empty_patterns_throw)
+{
+    EXPECT_THROW(dbc::set_site_rules("+function:"), std::invalid_argument);
+    EXPECT_THROW(dbc::disable_sites(""), std::invalid_argument);
+}
+
+TEST(Site_rules, Missing_environment_config_files_are_reported_and_enable_all_the_sites)
+{
+    ::setenv("DBC_SITES_FILE", "/nonexistent/dbc_site_rules.txt", 1);
+    ::setenv("DBC_SITES", "-*", 1);
+    testing::internal::CaptureStderr();
+
+    const auto rules = dbc::details::read_env_site_rules();
+
+    EXPECT_THAT(testing::internal::GetCapturedStderr(), HasSubstr("cannot open site rules file"));
+    EXPECT_TRUE(rules.empty());
+
+    ::unsetenv("DBC_SITES_FILE");
+    ::unsetenv("DBC_SITES");
+}
+
+TEST(Site_rules, Malformed_environment_config_files_are_reported_and_enable_all_the_sites)
+{
+    const auto path = testing::TempDir() + "dbc_malformed_site_rules.txt";
+    std::ofstream{path} << "-*\n"
+                           "-function:\n";
+
+    ::setenv("DBC_SITES_FILE", path.c_str(), 1);
+    testing::internal::CaptureStderr();
+
+    const auto rules = dbc::details::read_env_site_rules();
+
+    EXPECT_THAT(testing::internal::GetCapturedStderr(), HasSubstr("-function:"));
+    EXPECT_TRUE(rules.empty());
+
+    ::unsetenv("DBC_SITES_FILE");
+    std::remove(path.c_str());
+}
+
+TEST(Site_rules, Globs_match_any_sequence_and_any_character)
+{
+    using dbc::details::glob_match;
+
+    EXPECT_TRUE(glob_match("*", ""));
+    EXPECT_TRUE(glob_match("*/net/*.cpp", "src/net/socket.cpp"));
+    EXPECT_TRUE(glob_match("a?c*", "abcdef"));
+    EXPECT_FALSE(glob_match("*/net/*", "src/netx/socket.cpp"));
+    EXPECT_FALSE(glob_match("abc", "abcd"));
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
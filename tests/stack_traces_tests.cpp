@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <sstream>
+
+// External linkage, to be symbolized.
+namespace traced
+{
+
+[[gnu::noinline]] void require_positive(int x)
+{
+    DBC_REQUIRE(x > 0);
+}
+
+// The violating branch above may be split into a local .cold clone, that dladdr cannot name, so
+// symbolization is checked on this caller frame instead.
+[[gnu::noinline]] void forward(int x)
+{
+    require_positive(x);
+    asm volatile(""); // not a tail call
+}
+
+} // namespace traced
+
+namespace
+{
+
+class Given_a_recording_handler : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dbc::set_violation_handler([this](const auto& context) { recorded = context; });
+    }
+
+    void TearDown() override
+    {
+        dbc::set_stack_traces(false);
+        dbc::set_violation_handler(noop);
+    }
+
+    dbc::violation_context recorded{};
+    dbc::violation_handler noop;
+};
+
+using testing::HasSubstr;
+using traced::require_positive;
+
+TEST_F(Given_a_recording_handler, Stack_traces_are_not_captured_on_default)
+{
+    require_positive(0);
+
+    EXPECT_EQ(recorded.condition, "x > 0");
+    EXPECT_EQ(recorded.stack->size, 0);
+}
+
+TEST_F(Given_a_recording_handler, Stack_traces_are_captured_if_enabled)
+{
+    dbc::set_stack_traces(true);
+
+    require_positive(0);
+
+    ASSERT_GT(recorded.stack->size, 2);
+    EXPECT_LE(recorded.stack->size, dbc::stack_trace::capacity);
+    for (std::size_t i = 0; i < recorded.stack->size; ++i)
+        EXPECT_NE(recorded.stack->frames[i], nullptr);
+}
+
+TEST_F(Given_a_recording_handler, Stack_traces_start_at_the_violating_function)
+{
+    dbc::set_stack_traces(true);
+
+    require_positive(0);
+
+    ASSERT_GT(recorded.stack->size, 2);
+    for (std::size_t i = 0; i < recorded.stack->size; ++i)
+        EXPECT_THAT(dbc::symbolize(recorded.stack->frames[i]), testing::Not(HasSubstr("dbc::")));
+}
+
+TEST_F(Given_a_recording_handler, Stack_traces_are_symbolized_when_formatted)
+{
+    dbc::set_stack_traces(true);
+
+    traced::forward(0);
+
+    std::ostringstream os;
+    os << recorded;
+
+    EXPECT_THAT(os.str(), HasSubstr("Stack trace:\n  #0 0x"));
+    EXPECT_THAT(os.str(), HasSubstr("traced::forward(int)+0x")); // requires -rdynamic
+}
+
+TEST_F(Given_a_recording_handler, Stack_traces_are_not_symbolized_by_the_safe_formatting)
+{
+    dbc::set_stack_traces(true);
+
+    require_positive(0);
+
+    dbc::details::fixed_buffer<4096> buf;
+    dbc::details::format(buf, recorded);
+    const std::string_view formatted{buf.data(), buf.size()};
+
+    std::ostringstream first_frame;
+    first_frame << "Stack trace:\n  #0 " << recorded.stack->frames[0] << '\n';
+
+    EXPECT_THAT(formatted, HasSubstr(first_frame.str()));
+    EXPECT_THAT(formatted, testing::Not(HasSubstr("traced::")));
+}
+
+TEST(A_fixed_buffer, Appends_hex_values)
+{
+    dbc::details::fixed_buffer<64> buf;
+    buf.append_hex(0).append(" ").append_hex(0xdeadbeef);
+
+    EXPECT_EQ(std::string_view(buf.data(), buf.size()), "0x0 0xdeadbeef");
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+#define DBC_TRACEPOINTS
+
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class Given_a_set_handler : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dbc::set_violation_handler(handler.AsStdFunction());
+        fired_probes().clear();
+    }
+
+    void TearDown() override { dbc::set_violation_handler(noop); }
+
+    using mock_handler = testing::NiceMock<testing::MockFunction<dbc::violation_handler>>;
+
+    mock_handler handler;
+    dbc::violation_handler noop;
+};
+
+using testing::ElementsAre;
+using testing::Field;
+
+auto probe(std::string_view name, dbc::contract type, int held)
+{
+    return AllOf(Field(&fired_probe::name, name), Field(&fired_probe::condition, "x == 1"),
+                 Field(&fired_probe::file, __FILE__),
+                 Field(&fired_probe::type, static_cast<int>(type)),
+                 Field(&fired_probe::held, held));
+}
+
+TEST_F(Given_a_set_handler, Evaluations_fire_the_begin_and_end_probes)
+{
+    const auto x = 1;
+
+    DBC_REQUIRE(x == 1);
+
+    EXPECT_THAT(fired_probes(),
+                ElementsAre(probe("evaluate_begin", dbc::contract::precondition, -1),
+                            probe("evaluate_end", dbc::contract::precondition, 1)));
+}
+
+TEST_F(Given_a_set_handler, Violations_fire_the_violation_probe)
+{
+    const auto x = 2;
+
+    DBC_INVARIANT(x == 1, "What");
+
+    EXPECT_THAT(fired_probes(), ElementsAre(probe("evaluate_begin", dbc::contract::invariant, -1),
+                                            probe("evaluate_end", dbc::contract::invariant, 0),
+                                            probe("violation", dbc::contract::invariant, -1)));
+}
+
+TEST_F(Given_a_set_handler, Probes_carry_a_per_site_id)
+{
+    const auto x = 2;
+
+    for (auto i = 0; i < 2; ++i) DBC_REQUIRE(x == 1);
+    DBC_REQUIRE(x == 1);
+
+    ASSERT_EQ(fired_probes().size(), 9);
+    const auto* site = fired_probes()[0].condition.data();
+    EXPECT_EQ(fired_probes()[1].condition.data(), site);
+    EXPECT_EQ(fired_probes()[2].condition.data(), site); // violation
+    EXPECT_EQ(fired_probes()[3].condition.data(), site);
+    EXPECT_NE(fired_probes()[6].condition.data(), site); // same condition, other site
+}
+
+TEST_F(Given_a_set_handler, Probes_carry_the_line)
+{
+    const auto x = 1;
+
+    const auto line = __LINE__ + 1;
+    DBC_ENSURE(x == 1);
+
+    ASSERT_EQ(fired_probes().size(), 2);
+    EXPECT_EQ(fired_probes()[0].line, line);
+    EXPECT_EQ(fired_probes()[1].line, line);
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#define DBC_ASSERT_LEVEL_INVARIANTS
+
+#include "dbc/dbc.hpp"
+#include "dbc/handlers.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <limits>
+
+namespace
+{
+
+auto make_context(int32_t line = 100)
+{
+    return dbc::details::make_context(dbc::contract::invariant, "x == 0", "8 == 0", "main",
+                                      "path_to_buzz/buzz.cpp", line, "What");
+}
+
+TEST(The_abort_handler, Logs_and_aborts)
+{
+    EXPECT_DEATH(dbc::abort_handler(make_context()),
+                 "Invariant:\n  x == 0\nwith expansion:\n  8 == 0");
+}
+
+TEST(The_safe_abort_handler, Logs_and_aborts)
+{
+    EXPECT_DEATH(dbc::safe_abort_handler(make_context()),
+                 "Invariant:\n  x == 0\nwith expansion:\n  8 == 0\nFunction: main, file: "
+                 "path_to_buzz/buzz.cpp, line: 100\n");
+}
+
+TEST(The_safe_abort_handler, Formats_as_the_ostream_operator)
+{
+    for (const auto line : {0, -7, 42, std::numeric_limits<int32_t>::min()})
+    {
+        const auto context = make_context(line);
+
+        std::ostringstream os;
+        os << context << '\n';
+
+        dbc::details::fixed_buffer<4096> buf;
+        dbc::details::format(buf, context);
+
+        EXPECT_EQ(std::string_view(buf.data(), buf.size()), os.str());
+    }
+}
+
+TEST(The_safe_abort_handler, Truncates_long_violations)
+{
+    dbc::details::fixed_buffer<8> buf;
+    buf.append("Design").append(123456);
+
+    EXPECT_EQ(std::string_view(buf.data(), buf.size()), "Design12");
+}
+
+TEST(The_throw_handler, Throws_a_contract_violation)
+{
+    const auto context = make_context();
+
+    EXPECT_THROW(dbc::throw_handler(context), dbc::contract_violation);
+
+    try
+    {
+        dbc::throw_handler(context);
+    } catch (const dbc::contract_violation& e)
+    {
+        EXPECT_EQ(e.context(), context);
+    }
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        ::testing::InitGoogleMock(&argc, argv);
+
+        return RUN_ALL_TESTS();
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    } catch (...)
+    {
+        std::cerr << "Unexpected error!\n";
+
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Dumps the records of a dbc flight recorder file, e.g. after a crash.
+// Usage: dbc_flight_dump <path>...
+
+#include "dbc/flight_recorder.hpp"
+#include <cstdlib>
+#include <iostream>
+
+auto main(int argc, char* argv[]) -> int
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <flight recorder file>...\n";
+
+        return EXIT_FAILURE;
+    }
+
+    auto status = EXIT_SUCCESS;
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        try
+        {
+            const auto records = dbc::load_flight_records(argv[i]);
+
+            std::cout << argv[i] << ": " << records.size() << " record(s)\n";
+
+            const dbc::flight_record* previous{nullptr};
+            for (const auto& record : records)
+            {
+                if (!previous || previous->thread_id != record.thread_id)
+                    std::cout << "Thread id: " << record.thread_id << '\n';
+
+                previous = &record;
+
+                std::cout << "  " << record << '\n';
+            }
+        } catch (const std::exception& e)
+        {
+            std::cerr << argv[i] << ": " << e.what() << '\n';
+
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
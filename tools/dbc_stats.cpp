@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 SoultatosStefanos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+// Prints the counters of a dbc shared stats file, most violated sites first, optionally refreshing
+// them every interval seconds.
+// Usage: dbc_stats <path> [interval]
+
+#include "dbc/shared_stats.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+void print(const std::vector<dbc::shared_stat>& stats)
+{
+    std::cout << std::setw(14) << "violations" << std::setw(16) << "evaluations" << "  site\n";
+
+    for (const auto& stat : stats)
+    {
+        std::cout << std::setw(14) << stat.violations << std::setw(16) << stat.evaluations << "  "
+                  << dbc::to_string_view(stat.type) << ": " << stat.condition << " (" << stat.file
+                  << ':' << stat.line << ")\n";
+    }
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <shared stats file> [interval seconds]\n";
+
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        const auto interval = argc == 3 ? std::stod(argv[2]) : 0.0;
+
+        while (true)
+        {
+            const auto stats = dbc::load_shared_stats(argv[1]);
+
+            if (interval > 0) std::cout << "\033[H\033[2J"; // clear the terminal
+
+            std::cout << argv[1] << ": " << stats.size() << " site(s)\n";
+            print(stats);
+            std::cout << std::flush;
+
+            if (interval <= 0) break;
+
+            std::this_thread::sleep_for(std::chrono::duration<double>{interval});
+        }
+    } catch (const std::exception& e)
+    {
+        std::cerr << argv[1] << ": " << e.what() << '\n';
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}